@@ -0,0 +1,492 @@
+#include "batch.h"
+#include "matrix.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(const Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /**
+     * @brief Читает матрицу из файла: размеры "N M", затем N*M элементов построчно.
+     */
+    bool read_matrix_file(const std::string& path, std::vector<std::vector<double>>& matrix, std::string& error) {
+        std::ifstream file(path);
+        if (!file) {
+            error = "cannot open file '" + path + "'";
+            return false;
+        }
+        size_t n, m;
+        if (!(file >> n >> m) || n == 0 || m == 0) {
+            error = "invalid matrix dimensions in '" + path + "'";
+            return false;
+        }
+        if (n > std::numeric_limits<uint16_t>::max() || m > std::numeric_limits<uint16_t>::max()) {
+            error = "matrix in '" + path + "' is too large";
+            return false;
+        }
+        matrix.assign(n, std::vector(m, 0.0));
+        size_t nnz = 0;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < m; ++j) {
+                if (!(file >> matrix[i][j])) {
+                    error = "unexpected end of matrix data in '" + path + "'";
+                    return false;
+                }
+                nnz += matrix[i][j] != 0.0;
+            }
+        }
+        if (nnz > Matrix::MAX_NONZEROS) {
+            error = "matrix in '" + path + "' has too many nonzero elements";
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Читает вектор из файла: длина "N", затем N элементов.
+     */
+    bool read_vector_file(const std::string& path, std::vector<double>& vector, std::string& error) {
+        std::ifstream file(path);
+        if (!file) {
+            error = "cannot open file '" + path + "'";
+            return false;
+        }
+        size_t n;
+        if (!(file >> n)) {
+            error = "invalid vector size in '" + path + "'";
+            return false;
+        }
+        vector.assign(n, 0.0);
+        for (size_t i = 0; i < n; ++i) {
+            if (!(file >> vector[i])) {
+                error = "unexpected end of vector data in '" + path + "'";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Решает систему с треугольной матрицей, выбирая прямую или обратную подстановку по структуре.
+     *
+     * Все условия, при которых подстановка завершилась бы ошибкой, проверяются заранее:
+     * причина попадает в `error`, а сообщения библиотеки не смешиваются с выводом результатов.
+     */
+    bool solve_triangular_system(const Matrix& matrix, const std::vector<double>& rhs, std::vector<double>& solution, std::string& error) {
+        if (!matrix.is_square_matrix()) {
+            error = "matrix is not square";
+            return false;
+        }
+        if (rhs.size() != matrix.get_count_rows()) {
+            error = "right-hand side has " + std::to_string(rhs.size()) + " elements, expected " +
+                std::to_string(matrix.get_count_rows());
+            return false;
+        }
+        const bool is_lower = matrix.is_lower_triangular();
+        if (!is_lower && !matrix.is_upper_triangular()) {
+            error = "matrix is not triangular";
+            return false;
+        }
+        for (int j = 1; j <= matrix.get_count_rows(); j++) {
+            if (matrix.get_element(j, j) == 0.0) {
+                error = "matrix has a zero on the diagonal in row " + std::to_string(j);
+                return false;
+            }
+        }
+        solution = is_lower ? matrix.solve_lower_triangular(rhs) : matrix.solve_upper_triangular(rhs);
+        return true;
+    }
+
+    /**
+     * @brief Считает количество ненулевых элементов суммы или произведения двух матриц, не строя результат.
+     * @param is_product true — для lhs * rhs, false — для lhs + rhs.
+     *
+     * @details
+     * Строки результата накапливаются в плотном буфере длины числа столбцов; учитываются только позиции,
+     * которые были затронуты, поэтому стоимость — O(nnz) для суммы и O(числа умножений) для произведения.
+     * Нужна, чтобы отклонить операцию, результат которой не помещается в CSR (`Matrix::MAX_NONZEROS`).
+     */
+    size_t count_result_nonzeros(const Matrix& lhs, const Matrix& rhs, const bool is_product) {
+        const std::vector<double> lhs_values = lhs.get_values();
+        const std::vector<uint16_t> lhs_columns = lhs.get_column_idx();
+        const std::vector<uint16_t> lhs_rows = lhs.get_row_ptr();
+        const std::vector<double> rhs_values = rhs.get_values();
+        const std::vector<uint16_t> rhs_columns = rhs.get_column_idx();
+        const std::vector<uint16_t> rhs_rows = rhs.get_row_ptr();
+
+        std::vector<double> accumulator(rhs.get_count_cols(), 0.0);
+        std::vector<bool> is_touched(rhs.get_count_cols(), false);
+        std::vector<uint16_t> touched;
+        size_t nnz = 0;
+        const auto add = [&](const uint16_t col, const double value) {
+            if (!is_touched[col]) {
+                is_touched[col] = true;
+                touched.push_back(col);
+            }
+            accumulator[col] += value;
+        };
+        for (uint16_t row = 0; row < lhs.get_count_rows(); row++) {
+            for (uint16_t i = lhs_rows[row]; i < lhs_rows[row + 1]; i++) {
+                if (is_product) {
+                    const uint16_t k = lhs_columns[i];
+                    for (uint16_t p = rhs_rows[k]; p < rhs_rows[k + 1]; p++) {
+                        add(rhs_columns[p], lhs_values[i] * rhs_values[p]);
+                    }
+                } else {
+                    add(lhs_columns[i], lhs_values[i]);
+                }
+            }
+            if (!is_product) {
+                for (uint16_t i = rhs_rows[row]; i < rhs_rows[row + 1]; i++) {
+                    add(rhs_columns[i], rhs_values[i]);
+                }
+            }
+            for (const uint16_t col : touched) {
+                nnz += accumulator[col] != 0.0;
+                accumulator[col] = 0.0;
+                is_touched[col] = false;
+            }
+            touched.clear();
+        }
+        return nnz;
+    }
+
+    void write_json_string(std::ostream& output, const std::string& text) {
+        output << '"';
+        for (const char symbol : text) {
+            switch (symbol) {
+                case '"': output << "\\\""; break;
+                case '\\': output << "\\\\"; break;
+                case '\n': output << "\\n"; break;
+                case '\t': output << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(symbol) < 0x20) {
+                        output << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(symbol)
+                               << std::dec << std::setfill(' ');
+                    } else {
+                        output << symbol;
+                    }
+            }
+        }
+        output << '"';
+    }
+
+    void write_json_number(std::ostream& output, const double number) {
+        if (std::isfinite(number)) {
+            output << number;
+        } else {
+            output << "null";
+        }
+    }
+}
+
+/**
+ * @brief Разбирает манифест пакетного режима.
+ * @param manifest Поток с текстом манифеста.
+ * @param base_dir Каталог, относительно которого разрешаются относительные пути к файлам.
+ * @param jobs Выходной список операций (в порядке строк манифеста).
+ * @param error Описание ошибки разбора (с номером строки).
+ * @return true, если манифест корректен.
+ *
+ * @details
+ * Для каждой операции запоминаются индексы операций, определивших используемые ею матрицы.
+ * Эти индексы образуют граф зависимостей: всё, что не связано зависимостями, выполняется параллельно.
+ */
+bool parse_batch_manifest(std::istream& manifest, const std::string& base_dir, std::vector<BatchJob>& jobs, std::string& error) {
+    std::unordered_map<std::string, size_t> definitions;
+    std::string text;
+    size_t line = 0;
+
+    const auto resolve_path = [&](const std::string& path) {
+        const std::filesystem::path file_path(path);
+        return file_path.is_relative() && !base_dir.empty() ? (std::filesystem::path(base_dir) / file_path).string() : path;
+    };
+
+    while (std::getline(manifest, text)) {
+        line++;
+        std::istringstream tokens(text);
+        std::vector<std::string> args;
+        std::string token;
+        while (tokens >> token) {
+            args.push_back(token);
+        }
+        if (args.empty() || args[0][0] == '#') continue;
+
+        BatchJob job;
+        job.line = line;
+        job.op = args[0];
+
+        const auto expect_args = [&](const size_t count, const char* usage) {
+            if (args.size() != count) {
+                error = "line " + std::to_string(line) + ": expected '" + usage + "'";
+                return false;
+            }
+            return true;
+        };
+        const auto add_input = [&](const std::string& name) {
+            const auto found = definitions.find(name);
+            if (found == definitions.end()) {
+                error = "line " + std::to_string(line) + ": matrix '" + name + "' is not defined";
+                return false;
+            }
+            job.inputs.push_back(found->second);
+            return true;
+        };
+
+        if (job.op == "load") {
+            if (!expect_args(3, "load <name> <file>")) return false;
+            job.target = args[1];
+            job.path = resolve_path(args[2]);
+        } else if (job.op == "add" || job.op == "multiply") {
+            if (!expect_args(4, (job.op + " <name> <lhs> <rhs>").c_str())) return false;
+            job.target = args[1];
+            if (!add_input(args[2]) || !add_input(args[3])) return false;
+        } else if (job.op == "scale") {
+            if (!expect_args(4, "scale <name> <matrix> <scalar>")) return false;
+            job.target = args[1];
+            if (!add_input(args[2])) return false;
+            std::istringstream scalar(args[3]);
+            if (!(scalar >> job.scalar) || !scalar.eof()) {
+                error = "line " + std::to_string(line) + ": invalid scalar '" + args[3] + "'";
+                return false;
+            }
+        } else if (job.op == "trace" || job.op == "determinant") {
+            if (!expect_args(2, (job.op + " <matrix>").c_str())) return false;
+            if (!add_input(args[1])) return false;
+        } else if (job.op == "solve") {
+            if (!expect_args(3, "solve <matrix> <file>")) return false;
+            if (!add_input(args[1])) return false;
+            job.path = resolve_path(args[2]);
+        } else {
+            error = "line " + std::to_string(line) + ": unknown operation '" + job.op + "'";
+            return false;
+        }
+
+        if (!job.target.empty()) {
+            definitions[job.target] = jobs.size();
+        }
+        jobs.push_back(std::move(job));
+    }
+    return true;
+}
+
+/**
+ * @brief Выполняет операции манифеста на пуле потоков с перехватом задач.
+ * @param jobs Операции, полученные из `parse_batch_manifest`.
+ * @param count_threads Количество рабочих потоков.
+ * @return Результаты в порядке операций манифеста.
+ *
+ * @details
+ * **Алгоритм:**
+ * 1. Для каждой операции считаем число невыполненных зависимостей.
+ * 2. Операции без зависимостей (как правило, `load`) сразу отправляются в пул, поэтому чтение
+ *    файлов идёт параллельно с вычислениями над уже загруженными матрицами.
+ * 3. Завершившаяся операция уменьшает счётчики зависящих от неё; обнулившиеся отправляются в пул
+ *    из того же потока и выполняются им в первую очередь, остальные потоки могут их перехватить.
+ * 4. Если зависимость завершилась с ошибкой, операция не выполняется и тоже помечается ошибкой.
+ */
+std::vector<BatchResult> run_batch(const std::vector<BatchJob>& jobs, const size_t count_threads) {
+    const size_t count = jobs.size();
+    std::vector<BatchResult> results(count);
+    std::vector<std::shared_ptr<const Matrix>> matrices(count);
+    std::vector<std::vector<size_t>> dependents(count);
+    const std::unique_ptr<std::atomic<size_t>[]> remaining(new std::atomic<size_t>[count]);
+    for (size_t i = 0; i < count; i++) {
+        remaining[i].store(jobs[i].inputs.size(), std::memory_order_relaxed);
+        for (const size_t input : jobs[i].inputs) {
+            dependents[input].push_back(i);
+        }
+    }
+
+    const auto execute = [&](const size_t index) {
+        const BatchJob& job = jobs[index];
+        BatchResult& result = results[index];
+        result.line = job.line;
+        result.op = job.op;
+        result.target = job.target;
+        const Clock::time_point start = Clock::now();
+
+        std::vector<std::shared_ptr<const Matrix>> inputs;
+        for (const size_t input : job.inputs) {
+            if (!matrices[input]) {
+                result.message = "dependency on line " + std::to_string(jobs[input].line) + " failed";
+                result.time_ms = elapsed_ms(start);
+                return;
+            }
+            inputs.push_back(matrices[input]);
+        }
+
+        std::shared_ptr<const Matrix> output;
+        std::string error;
+        if (job.op == "load") {
+            std::vector<std::vector<double>> data;
+            if (read_matrix_file(job.path, data, error)) {
+                output = std::make_shared<const Matrix>(data);
+            }
+        } else if (job.op == "add") {
+            if (inputs[0]->get_count_rows() != inputs[1]->get_count_rows() ||
+                inputs[0]->get_count_cols() != inputs[1]->get_count_cols()) {
+                error = "matrices cannot be added: inconsistent sizes";
+            } else if (count_result_nonzeros(*inputs[0], *inputs[1], false) > Matrix::MAX_NONZEROS) {
+                error = "sum has too many nonzero elements";
+            } else {
+                output = std::make_shared<const Matrix>(*inputs[0] + *inputs[1]);
+            }
+        } else if (job.op == "multiply") {
+            if (inputs[0]->get_count_cols() != inputs[1]->get_count_rows()) {
+                error = "matrices cannot be multiplied: inconsistent sizes";
+            } else if (count_result_nonzeros(*inputs[0], *inputs[1], true) > Matrix::MAX_NONZEROS) {
+                error = "product has too many nonzero elements";
+            } else {
+                output = std::make_shared<const Matrix>(*inputs[0] * *inputs[1]);
+            }
+        } else if (job.op == "scale") {
+            Matrix scaled = *inputs[0];
+            output = std::make_shared<const Matrix>(scaled * job.scalar);
+        } else if (job.op == "trace" || job.op == "determinant") {
+            if (!inputs[0]->is_square_matrix()) {
+                error = "matrix is not square";
+            } else {
+                result.has_value = true;
+                result.value = job.op == "trace" ? inputs[0]->get_trace() : inputs[0]->get_determinant();
+            }
+        } else if (job.op == "solve") {
+            std::vector<double> rhs;
+            if (read_vector_file(job.path, rhs, error)) {
+                solve_triangular_system(*inputs[0], rhs, result.solution, error);
+            }
+        }
+
+        if (output) {
+            result.has_matrix = true;
+            result.rows = output->get_count_rows();
+            result.cols = output->get_count_cols();
+            result.nnz = output->get_values().size();
+            matrices[index] = std::move(output);
+        }
+        result.ok = error.empty();
+        result.message = error;
+        result.time_ms = elapsed_ms(start);
+    };
+
+    ThreadPool pool(count_threads);
+    std::function<void(size_t)> schedule = [&](const size_t index) {
+        pool.submit([&, index] {
+            execute(index);
+            for (const size_t dependent : dependents[index]) {
+                if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    schedule(dependent);
+                }
+            }
+        });
+    };
+    for (size_t i = 0; i < count; i++) {
+        if (jobs[i].inputs.empty()) {
+            schedule(i);
+        }
+    }
+    pool.wait();
+    return results;
+}
+
+/**
+ * @brief Записывает результаты в формате JSON Lines: одна строка на операцию и итоговая строка `summary`.
+ */
+void write_batch_results(std::ostream& output, const std::vector<BatchResult>& results, const size_t count_threads, const double wall_ms) {
+    output << std::setprecision(15);
+    size_t count_ok = 0;
+    for (const BatchResult& result : results) {
+        count_ok += result.ok;
+        output << "{\"line\": " << result.line << ", \"op\": ";
+        write_json_string(output, result.op);
+        if (!result.target.empty()) {
+            output << ", \"target\": ";
+            write_json_string(output, result.target);
+        }
+        output << ", \"status\": " << (result.ok ? "\"ok\"" : "\"error\"");
+        if (!result.ok) {
+            output << ", \"message\": ";
+            write_json_string(output, result.message);
+        }
+        if (result.has_matrix) {
+            output << ", \"rows\": " << result.rows << ", \"cols\": " << result.cols << ", \"nnz\": " << result.nnz;
+        }
+        if (result.has_value) {
+            output << ", \"value\": ";
+            write_json_number(output, result.value);
+        }
+        if (result.ok && result.op == "solve") {
+            output << ", \"solution\": [";
+            for (size_t i = 0; i < result.solution.size(); i++) {
+                if (i > 0) output << ", ";
+                write_json_number(output, result.solution[i]);
+            }
+            output << "]";
+        }
+        output << ", \"time_ms\": " << result.time_ms << "}\n";
+    }
+    output << "{\"summary\": {\"jobs\": " << results.size() << ", \"ok\": " << count_ok
+           << ", \"failed\": " << results.size() - count_ok << ", \"threads\": " << count_threads
+           << ", \"wall_ms\": " << wall_ms << "}}\n";
+}
+
+/**
+ * @brief Точка входа пакетного режима: читает манифест, выполняет операции и записывает результаты.
+ * @param manifest_path Путь к манифесту. Относительные пути внутри него считаются от его каталога.
+ * @param output_path Путь к файлу результатов; пустая строка — стандартный вывод.
+ * @param count_threads Количество рабочих потоков (0 — по числу ядер).
+ * @return 0 — все операции успешны, 1 — ошибка манифеста или ввода-вывода, 2 — часть операций завершилась с ошибкой.
+ */
+int run_batch_mode(const std::string& manifest_path, const std::string& output_path, size_t count_threads) {
+    std::ifstream manifest(manifest_path);
+    if (!manifest) {
+        std::cerr << "[LOG] [ERROR] Cannot open manifest '" << manifest_path << "'!" << std::endl;
+        return 1;
+    }
+    std::vector<BatchJob> jobs;
+    std::string error;
+    const std::string base_dir = std::filesystem::path(manifest_path).parent_path().string();
+    if (!parse_batch_manifest(manifest, base_dir, jobs, error)) {
+        std::cerr << "[LOG] [ERROR] " << manifest_path << ": " << error << std::endl;
+        return 1;
+    }
+    if (count_threads == 0) {
+        count_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const Clock::time_point start = Clock::now();
+    const std::vector<BatchResult> results = run_batch(jobs, count_threads);
+    const double wall_ms = elapsed_ms(start);
+
+    std::ofstream file;
+    if (!output_path.empty()) {
+        file.open(output_path);
+        if (!file) {
+            std::cerr << "[LOG] [ERROR] Cannot open output file '" << output_path << "'!" << std::endl;
+            return 1;
+        }
+    }
+    write_batch_results(output_path.empty() ? std::cout : file, results, count_threads, wall_ms);
+
+    for (const BatchResult& result : results) {
+        if (!result.ok) return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Одна операция из файла-манифеста пакетного режима.
+ *
+ * Формат строк манифеста (пустые строки и строки, начинающиеся с `#`, пропускаются):
+ * ```
+ * load <имя> <файл>               — читает матрицу из файла ("N M", затем N*M элементов)
+ * add <имя> <левая> <правая>      — сумма двух матриц
+ * multiply <имя> <левая> <правая> — произведение двух матриц
+ * scale <имя> <матрица> <скаляр>  — умножение матрицы на скаляр
+ * trace <матрица>                 — след
+ * determinant <матрица>           — определитель
+ * solve <матрица> <файл>          — решение треугольной системы, правая часть в файле ("N", затем N элементов)
+ * ```
+ * Имена матриц можно переопределять: операция использует последнее определение выше по файлу.
+ */
+struct BatchJob {
+    size_t line = 0;
+    std::string op;
+    std::string target;
+    std::vector<size_t> inputs;
+    std::string path;
+    double scalar = 0.0;
+};
+
+/**
+ * @brief Результат выполнения одной операции.
+ */
+struct BatchResult {
+    size_t line = 0;
+    std::string op;
+    std::string target;
+    bool ok = false;
+    std::string message;
+
+    bool has_matrix = false;
+    uint16_t rows = 0;
+    uint16_t cols = 0;
+    size_t nnz = 0;
+
+    bool has_value = false;
+    double value = 0.0;
+
+    std::vector<double> solution;
+
+    double time_ms = 0.0;
+};
+
+bool parse_batch_manifest(std::istream& manifest, const std::string& base_dir, std::vector<BatchJob>& jobs, std::string& error);
+std::vector<BatchResult> run_batch(const std::vector<BatchJob>& jobs, size_t count_threads);
+void write_batch_results(std::ostream& output, const std::vector<BatchResult>& results, size_t count_threads, double wall_ms);
+
+int run_batch_mode(const std::string& manifest_path, const std::string& output_path, size_t count_threads);
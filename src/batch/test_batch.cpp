@@ -0,0 +1,129 @@
+#include "test_batch.h"
+#include "batch.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// Тест разбора манифеста с ошибками
+void test_batch_manifest_errors() {
+    std::vector<BatchJob> jobs;
+    std::string error;
+
+    std::istringstream undefined("load A a.txt\nadd C A B\n");
+    CU_ASSERT_TRUE(!parse_batch_manifest(undefined, "", jobs, error));
+    CU_ASSERT_EQUAL(error, "line 2: matrix 'B' is not defined");
+
+    jobs.clear();
+    std::istringstream unknown("# comment\n\ninvert A\n");
+    CU_ASSERT_TRUE(!parse_batch_manifest(unknown, "", jobs, error));
+    CU_ASSERT_EQUAL(error, "line 3: unknown operation 'invert'");
+}
+
+// Тест выполнения манифеста: зависимости, результаты и ошибки операций
+void test_batch_run() {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "lin_alg_lib_test_batch";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "a.txt") << "3 3\n5 0 0\n0 8 0\n3 0 6\n";
+    std::ofstream(dir / "b.txt") << "3 3\n1 2 3\n4 5 6\n7 8 9\n";
+    std::ofstream(dir / "rhs.txt") << "3\n10 16 15\n";
+
+    std::istringstream manifest(
+        "load A a.txt\n"
+        "load B b.txt\n"
+        "add C A B\n"
+        "scale D C 2\n"
+        "trace D\n"
+        "determinant A\n"
+        "solve A rhs.txt\n"
+        "solve B rhs.txt\n"
+        "load E missing.txt\n"
+        "trace E\n");
+    std::vector<BatchJob> jobs;
+    std::string error;
+    CU_ASSERT_TRUE(parse_batch_manifest(manifest, dir.string(), jobs, error));
+    CU_ASSERT_EQUAL(jobs.size(), 10);
+
+    const std::vector<BatchResult> results = run_batch(jobs, 4);
+    CU_ASSERT_EQUAL(results.size(), 10);
+    CU_ASSERT_TRUE(results[2].ok && results[2].has_matrix);
+    CU_ASSERT_EQUAL(results[2].nnz, 9);
+    CU_ASSERT_TRUE(results[4].ok);
+    CU_ASSERT_DOUBLE_EQUAL(results[4].value, 68.0, 1e-9);
+    CU_ASSERT_DOUBLE_EQUAL(results[5].value, 240.0, 1e-9);
+    CU_ASSERT_TRUE(results[6].ok);
+    CU_ASSERT_EQUAL(results[6].solution.size(), 3);
+    CU_ASSERT_DOUBLE_EQUAL(results[6].solution[0], 2.0, 1e-9);
+    CU_ASSERT_DOUBLE_EQUAL(results[6].solution[1], 2.0, 1e-9);
+    CU_ASSERT_DOUBLE_EQUAL(results[6].solution[2], 1.5, 1e-9);
+    CU_ASSERT_TRUE(!results[7].ok);
+    CU_ASSERT_EQUAL(results[7].message, "matrix is not triangular");
+    CU_ASSERT_TRUE(!results[8].ok);
+    CU_ASSERT_TRUE(!results[9].ok);
+    CU_ASSERT_EQUAL(results[9].message, "dependency on line 9 failed");
+
+    std::filesystem::remove_all(dir);
+}
+
+// Тест выполнения манифеста с некорректными операндами: ошибки сообщаются в результатах заданий
+void test_batch_invalid_operands() {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "lin_alg_lib_test_batch_invalid";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "l.txt") << "3 3\n1 0 0\n2 0 0\n3 4 5\n";
+    std::ofstream(dir / "rhs.txt") << "2\n1 2\n";
+    std::ofstream(dir / "rhs3.txt") << "3\n1 2 3\n";
+
+    // Столбец и строка из единиц 256: их произведение содержит 65536 ненулевых элементов
+    std::ofstream column(dir / "column.txt");
+    column << "256 1\n";
+    for (int i = 0; i < 256; i++) column << "1\n";
+    column.close();
+    std::ofstream row(dir / "row.txt");
+    row << "1 256\n";
+    for (int i = 0; i < 256; i++) row << "1 ";
+    row.close();
+
+    // Верхняя и нижняя половины матрицы 256 x 256: по отдельности помещаются в CSR, сумма — нет
+    std::ofstream top(dir / "top.txt");
+    std::ofstream bottom(dir / "bottom.txt");
+    top << "256 256\n";
+    bottom << "256 256\n";
+    for (int i = 0; i < 256; i++) {
+        for (int j = 0; j < 256; j++) {
+            top << (i < 128 ? "1 " : "0 ");
+            bottom << (i < 128 ? "0 " : "1 ");
+        }
+        top << "\n";
+        bottom << "\n";
+    }
+    top.close();
+    bottom.close();
+
+    std::istringstream manifest(
+        "load L l.txt\n"
+        "solve L rhs.txt\n"
+        "solve L rhs3.txt\n"
+        "load U column.txt\n"
+        "load V row.txt\n"
+        "multiply P U V\n"
+        "load T top.txt\n"
+        "load B bottom.txt\n"
+        "add S T B\n");
+    std::vector<BatchJob> jobs;
+    std::string error;
+    CU_ASSERT_TRUE(parse_batch_manifest(manifest, dir.string(), jobs, error));
+
+    const std::vector<BatchResult> results = run_batch(jobs, 2);
+    CU_ASSERT_EQUAL(results.size(), 9);
+    CU_ASSERT_TRUE(!results[1].ok);
+    CU_ASSERT_EQUAL(results[1].message, "right-hand side has 2 elements, expected 3");
+    CU_ASSERT_TRUE(!results[2].ok);
+    CU_ASSERT_EQUAL(results[2].message, "matrix has a zero on the diagonal in row 2");
+    CU_ASSERT_TRUE(!results[5].ok && !results[5].has_matrix);
+    CU_ASSERT_EQUAL(results[5].message, "product has too many nonzero elements");
+    CU_ASSERT_TRUE(results[6].ok && results[7].ok);
+    CU_ASSERT_TRUE(!results[8].ok && !results[8].has_matrix);
+    CU_ASSERT_EQUAL(results[8].message, "sum has too many nonzero elements");
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+
+void test_batch_manifest_errors();
+void test_batch_run();
+void test_batch_invalid_operands();
@@ -0,0 +1,117 @@
+#include "thread_pool.h"
+#include "parallel.h"
+
+#include <algorithm>
+
+namespace {
+    // Пул и индекс очереди текущего рабочего потока (nullptr — поток не принадлежит пулу)
+    thread_local const ThreadPool* current_pool = nullptr;
+    thread_local size_t current_index = 0;
+}
+
+ThreadPool::ThreadPool(const size_t count_threads) {
+    const size_t count = std::max<size_t>(1, count_threads);
+    _queues.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+    _workers.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        _workers.emplace_back([this, i] { _worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(_mutex);
+        _stop = true;
+    }
+    _wake.notify_all();
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Добавляет задачу в пул.
+ * @param task Задача. Может сама добавлять новые задачи.
+ */
+void ThreadPool::submit(std::function<void()> task) {
+    const size_t index = current_pool == this
+        ? current_index
+        : _next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+    {
+        std::lock_guard lock(_mutex);
+        _queued++;
+        _pending++;
+    }
+    {
+        std::lock_guard lock(_queues[index]->mutex);
+        _queues[index]->tasks.push_back(std::move(task));
+    }
+    _wake.notify_one();
+}
+
+/**
+ * @brief Блокирует вызывающий поток, пока не будут выполнены все задачи (включая порождённые).
+ */
+void ThreadPool::wait() {
+    std::unique_lock lock(_mutex);
+    _idle.wait(lock, [this] { return _pending == 0; });
+}
+
+/**
+ * @brief Забирает задачу: сначала из конца своей очереди, затем из начала чужих.
+ * @return true, если задача найдена.
+ */
+bool ThreadPool::_take_task(const size_t index, std::function<void()>& task) {
+    {
+        Queue& own = *_queues[index];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < _queues.size(); offset++) {
+        Queue& victim = *_queues[(index + offset) % _queues.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::_worker_loop(const size_t index) {
+    current_pool = this;
+    current_index = index;
+    // Каждая задача уже занимает рабочий поток: вложенный parallel_for не должен порождать новые
+    is_parallel_worker = true;
+    while (true) {
+        std::function<void()> task;
+        if (_take_task(index, task)) {
+            {
+                std::lock_guard lock(_mutex);
+                _queued--;
+            }
+            task();
+            bool is_idle;
+            {
+                std::lock_guard lock(_mutex);
+                is_idle = --_pending == 0;
+            }
+            if (is_idle) {
+                _idle.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock lock(_mutex);
+        if (_stop && _queued == 0) return;
+        _wake.wait(lock, [this] { return _stop || _queued > 0; });
+        if (_stop && _queued == 0) return;
+    }
+}
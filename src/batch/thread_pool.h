@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Пул потоков с перехватом задач (work stealing).
+ *
+ * @details
+ * У каждого рабочего потока своя очередь. Задача, добавленная из рабочего потока, попадает в его очередь
+ * (в конец), и этот поток забирает её первой (LIFO — данные ещё в кэше). Свободный поток сначала
+ * проверяет свою очередь, а затем забирает самые старые задачи из начала чужих очередей.
+ * Задачи, добавленные извне пула, распределяются по очередям по кругу.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t count_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    size_t get_count_threads() const { return _workers.size(); }
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void _worker_loop(size_t index);
+    bool _take_task(size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _idle;
+    size_t _queued = 0;
+    size_t _pending = 0;
+    bool _stop = false;
+
+    std::atomic<size_t> _next_queue = 0;
+};
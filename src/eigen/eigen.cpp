@@ -0,0 +1,769 @@
+#include "eigen.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+
+namespace {
+    using Complex = std::complex<double>;
+
+    constexpr double EPSILON = std::numeric_limits<double>::epsilon();
+
+    // Циклы по n строкам распараллеливаются только для больших n: иначе запуск потоков дороже самой работы
+    constexpr size_t BLOCK_ROWS = 4096;
+    constexpr size_t PARALLEL_ROWS = 1 << 15;
+
+    /**
+     * @brief Рабочая память неявно перезапускаемого метода Арнольди/Ланцоша.
+     *
+     * Все буферы выделяются один раз в `implicitly_restarted` и переиспользуются каждым шагом и перезапуском:
+     * базис Крылова и буферы длины n занимают O(n * m), плотные матрицы m×m — O(m^2) памяти.
+     */
+    struct KrylovWorkspace {
+        size_t n = 0;
+        size_t m = 0;
+        std::vector<double> basis;        // n × (m + 1), столбцы подряд; столбец m — нормированная невязка
+        std::vector<double> h;            // m × m, построчно
+        std::vector<double> buffer;       // n × m для пересчёта базиса при перезапуске
+        std::vector<double> w;            // n
+        std::vector<double> projections;  // m + 1, коэффициенты Арнольди текущего шага
+        std::vector<double> pass;         // m + 1, проекции одного прохода Грама — Шмидта
+        double residual_norm = 0.0;
+        std::mt19937 generator{42};
+
+        // Плотные m×m буферы для значений Ритца и сдвигов
+        std::vector<double> h_copy;
+        std::vector<double> jacobi;
+        std::vector<Complex> schur;
+        std::vector<Complex> schur_basis;
+        std::vector<Complex> rotation_c;
+        std::vector<Complex> rotation_s;
+        std::vector<Complex> schur_vector;
+        std::vector<double> shifted;
+        std::vector<double> q;
+        std::vector<double> q_total;
+        std::vector<double> product;
+        std::vector<double> reflector;
+        std::vector<Complex> shifts;
+
+        std::vector<Complex> ritz_values;
+        std::vector<Complex> ritz_vectors;
+        std::vector<size_t> order;
+
+        double* column(const size_t j) { return basis.data() + j * n; }
+
+        void allocate(const size_t count_rows, const size_t subspace) {
+            n = count_rows;
+            m = subspace;
+            basis.assign(n * (m + 1), 0.0);
+            h.assign(m * m, 0.0);
+            buffer.assign(n * m, 0.0);
+            w.assign(n, 0.0);
+            projections.assign(m + 1, 0.0);
+            pass.assign(m + 1, 0.0);
+            h_copy.assign(m * m, 0.0);
+            jacobi.assign(m * m, 0.0);
+            schur.assign(m * m, 0.0);
+            schur_basis.assign(m * m, 0.0);
+            rotation_c.assign(m, 0.0);
+            rotation_s.assign(m, 0.0);
+            schur_vector.assign(m, 0.0);
+            shifted.assign(m * m, 0.0);
+            q.assign(m * m, 0.0);
+            q_total.assign(m * m, 0.0);
+            product.assign(m * m, 0.0);
+            reflector.assign(m, 0.0);
+            shifts.reserve(m);
+            ritz_values.assign(m, 0.0);
+            ritz_vectors.assign(m * m, 0.0);
+            order.assign(m, 0);
+        }
+    };
+
+    /**
+     * @brief Вызывает body(begin, end) для блоков строк; блоки идут в несколько потоков только при n >= PARALLEL_ROWS.
+     */
+    template<typename Function>
+    void for_row_blocks(const size_t n, Function&& body) {
+        const size_t count_blocks = (n + BLOCK_ROWS - 1) / BLOCK_ROWS;
+        parallel_for(0, count_blocks, [&](const size_t b) {
+            body(b * BLOCK_ROWS, std::min(n, (b + 1) * BLOCK_ROWS));
+        }, PARALLEL_ROWS / BLOCK_ROWS);
+    }
+
+    /**
+     * @brief Собственные значения и векторы симметричной матрицы ws.h (m×m) методом вращений Якоби.
+     *
+     * Результат — в ws.ritz_values и ws.ritz_vectors (построчно, i-й вектор — i-й столбец).
+     */
+    void symmetric_eigen(KrylovWorkspace& ws) {
+        const size_t m = ws.m;
+        std::vector<double>& a = ws.h_copy;
+        std::vector<double>& v = ws.jacobi;
+        std::copy(ws.h.begin(), ws.h.end(), a.begin());
+        std::fill(v.begin(), v.end(), 0.0);
+        for (size_t i = 0; i < m; i++) {
+            v[i * m + i] = 1.0;
+        }
+        double norm = 0.0;
+        for (const double element : a) {
+            norm += element * element;
+        }
+        for (size_t sweep = 0; sweep < 100; sweep++) {
+            double off = 0.0;
+            for (size_t p = 0; p < m; p++) {
+                for (size_t q = p + 1; q < m; q++) {
+                    off += a[p * m + q] * a[p * m + q];
+                }
+            }
+            if (off <= EPSILON * EPSILON * norm) break;
+            for (size_t p = 0; p < m; p++) {
+                for (size_t q = p + 1; q < m; q++) {
+                    const double apq = a[p * m + q];
+                    if (apq == 0.0) continue;
+                    const double theta = (a[q * m + q] - a[p * m + p]) / (2.0 * apq);
+                    const double t = (theta >= 0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                    const double c = 1.0 / std::sqrt(t * t + 1.0);
+                    const double s = t * c;
+                    for (size_t k = 0; k < m; k++) {
+                        const double akp = a[k * m + p], akq = a[k * m + q];
+                        a[k * m + p] = c * akp - s * akq;
+                        a[k * m + q] = s * akp + c * akq;
+                    }
+                    for (size_t k = 0; k < m; k++) {
+                        const double apk = a[p * m + k], aqk = a[q * m + k];
+                        a[p * m + k] = c * apk - s * aqk;
+                        a[q * m + k] = s * apk + c * aqk;
+                    }
+                    for (size_t k = 0; k < m; k++) {
+                        const double vkp = v[k * m + p], vkq = v[k * m + q];
+                        v[k * m + p] = c * vkp - s * vkq;
+                        v[k * m + q] = s * vkp + c * vkq;
+                    }
+                }
+            }
+        }
+        std::copy(v.begin(), v.end(), ws.ritz_vectors.begin());
+        for (size_t i = 0; i < m; i++) {
+            ws.ritz_values[i] = a[i * m + i];
+        }
+    }
+
+    /**
+     * @brief Собственные значения и векторы верхней хессенберговой матрицы ws.h (m×m).
+     * @return false, если QR-алгоритм не сошёлся. Результат — в ws.ritz_values и ws.ritz_vectors.
+     *
+     * @details
+     * Комплексный QR-алгоритм со сдвигами Уилкинсона (вращения Гивенса) приводит матрицу к форме Шура
+     * T = Z* H Z. Собственные значения — диагональ T, собственные векторы T находятся обратной
+     * подстановкой и переводятся в исходный базис умножением на Z. Комплексная арифметика позволяет
+     * не разбирать отдельно пары комплексно-сопряжённых значений вещественной матрицы.
+     */
+    bool hessenberg_eigen(KrylovWorkspace& ws) {
+        const size_t m = ws.m;
+        const std::vector<double>& h = ws.h;
+        std::vector<Complex>& t = ws.schur;
+        std::vector<Complex>& z = ws.schur_basis;
+        std::vector<Complex>& cs = ws.rotation_c;
+        std::vector<Complex>& ss = ws.rotation_s;
+        std::vector<Complex>& values = ws.ritz_values;
+        std::vector<Complex>& vectors = ws.ritz_vectors;
+        std::copy(h.begin(), h.end(), t.begin());
+        std::fill(z.begin(), z.end(), 0.0);
+        for (size_t i = 0; i < m; i++) {
+            z[i * m + i] = 1.0;
+        }
+        const auto T = [&](const size_t i, const size_t j) -> Complex& { return t[i * m + j]; };
+        double norm = 0.0;
+        for (const double element : h) {
+            norm = std::max(norm, std::fabs(element));
+        }
+        if (norm == 0.0) norm = 1.0;
+
+        size_t hi = m - 1;
+        size_t iter = 0, total = 0;
+        while (hi > 0) {
+            size_t l = hi;
+            while (l > 0) {
+                const double scale = std::abs(T(l - 1, l - 1)) + std::abs(T(l, l));
+                if (std::abs(T(l, l - 1)) <= EPSILON * (scale > 0.0 ? scale : norm)) {
+                    T(l, l - 1) = 0.0;
+                    break;
+                }
+                l--;
+            }
+            if (l == hi) {
+                hi--;
+                iter = 0;
+                continue;
+            }
+            if (++total > 100 * m) return false;
+            iter++;
+
+            Complex mu;
+            if (iter % 11 == 0) {
+                mu = T(hi, hi) + std::abs(T(hi, hi - 1));
+            } else {
+                const Complex a = T(hi - 1, hi - 1), b = T(hi - 1, hi), c = T(hi, hi - 1), d = T(hi, hi);
+                const Complex half = (a - d) * 0.5;
+                const Complex disc = std::sqrt(half * half + b * c);
+                const Complex mu1 = (a + d) * 0.5 + disc;
+                const Complex mu2 = (a + d) * 0.5 - disc;
+                mu = std::abs(mu1 - d) < std::abs(mu2 - d) ? mu1 : mu2;
+            }
+
+            for (size_t i = l; i <= hi; i++) {
+                T(i, i) -= mu;
+            }
+            for (size_t k = l; k < hi; k++) {
+                const Complex x = T(k, k), y = T(k + 1, k);
+                const double r = std::sqrt(std::norm(x) + std::norm(y));
+                cs[k] = r == 0.0 ? Complex(1.0) : x / r;
+                ss[k] = r == 0.0 ? Complex(0.0) : y / r;
+                for (size_t col = k; col < m; col++) {
+                    const Complex a = T(k, col), b = T(k + 1, col);
+                    T(k, col) = std::conj(cs[k]) * a + std::conj(ss[k]) * b;
+                    T(k + 1, col) = -ss[k] * a + cs[k] * b;
+                }
+            }
+            for (size_t k = l; k < hi; k++) {
+                for (size_t row = 0; row <= std::min(k + 1, hi); row++) {
+                    const Complex a = T(row, k), b = T(row, k + 1);
+                    T(row, k) = a * cs[k] + b * ss[k];
+                    T(row, k + 1) = -a * std::conj(ss[k]) + b * std::conj(cs[k]);
+                }
+                for (size_t row = 0; row < m; row++) {
+                    const Complex a = z[row * m + k], b = z[row * m + k + 1];
+                    z[row * m + k] = a * cs[k] + b * ss[k];
+                    z[row * m + k + 1] = -a * std::conj(ss[k]) + b * std::conj(cs[k]);
+                }
+            }
+            for (size_t i = l; i <= hi; i++) {
+                T(i, i) += mu;
+            }
+        }
+
+        std::vector<Complex>& schur_vector = ws.schur_vector;
+        for (size_t i = 0; i < m; i++) {
+            values[i] = T(i, i);
+            std::fill(schur_vector.begin(), schur_vector.end(), 0.0);
+            schur_vector[i] = 1.0;
+            for (size_t j = i; j-- > 0;) {
+                Complex sum = 0.0;
+                for (size_t p = j + 1; p <= i; p++) {
+                    sum += T(j, p) * schur_vector[p];
+                }
+                Complex denominator = T(j, j) - T(i, i);
+                if (std::abs(denominator) < EPSILON * norm) {
+                    denominator = EPSILON * norm;
+                }
+                schur_vector[j] = -sum / denominator;
+            }
+            double length = 0.0;
+            for (size_t row = 0; row < m; row++) {
+                Complex sum = 0.0;
+                for (size_t p = 0; p <= i; p++) {
+                    sum += z[row * m + p] * schur_vector[p];
+                }
+                vectors[row * m + i] = sum;
+                length += std::norm(sum);
+            }
+            length = std::sqrt(length);
+            for (size_t row = 0; row < m; row++) {
+                vectors[row * m + i] /= length;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief QR-разложение квадратной матрицы m×m отражениями Хаусхолдера; возвращает только Q.
+     * @param a Матрица, разрушается (на выходе — R).
+     * @param v Буфер длины m для вектора отражения.
+     */
+    void householder_q(std::vector<double>& a, const size_t m, std::vector<double>& q, std::vector<double>& v) {
+        std::fill(q.begin(), q.end(), 0.0);
+        for (size_t i = 0; i < m; i++) {
+            q[i * m + i] = 1.0;
+        }
+        for (size_t j = 0; j + 1 < m; j++) {
+            double length = 0.0;
+            for (size_t i = j; i < m; i++) {
+                length += a[i * m + j] * a[i * m + j];
+            }
+            length = std::sqrt(length);
+            if (length == 0.0) continue;
+            const double alpha = a[j * m + j] > 0 ? -length : length;
+            double v_norm = 0.0;
+            for (size_t i = j; i < m; i++) {
+                v[i] = a[i * m + j] - (i == j ? alpha : 0.0);
+                v_norm += v[i] * v[i];
+            }
+            if (v_norm == 0.0) continue;
+            for (size_t col = j; col < m; col++) {
+                double dot = 0.0;
+                for (size_t i = j; i < m; i++) {
+                    dot += v[i] * a[i * m + col];
+                }
+                dot *= 2.0 / v_norm;
+                for (size_t i = j; i < m; i++) {
+                    a[i * m + col] -= dot * v[i];
+                }
+            }
+            for (size_t row = 0; row < m; row++) {
+                double dot = 0.0;
+                for (size_t i = j; i < m; i++) {
+                    dot += q[row * m + i] * v[i];
+                }
+                dot *= 2.0 / v_norm;
+                for (size_t i = j; i < m; i++) {
+                    q[row * m + i] -= dot * v[i];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Ортогонализует w к первым count столбцам базиса (классический Грам — Шмидт, два прохода).
+     * @param projections Сумма проекций w на столбцы базиса (коэффициенты Арнольди), первые count элементов.
+     *
+     * @details
+     * Скалярные произведения считаются последовательно по столбцам (непрерывный доступ к памяти);
+     * по потокам они раскладываются только при n >= PARALLEL_ROWS.
+     */
+    void orthogonalize(KrylovWorkspace& ws, double* w, const size_t count, std::vector<double>& projections) {
+        const size_t n = ws.n;
+        std::fill(projections.begin(), projections.begin() + count, 0.0);
+        const auto dot = [&](const size_t c) {
+            const double* v = ws.column(c);
+            double sum = 0.0;
+            for (size_t r = 0; r < n; r++) {
+                sum += v[r] * w[r];
+            }
+            ws.pass[c] = sum;
+        };
+        for (int repeat = 0; repeat < 2; repeat++) {
+            if (n >= PARALLEL_ROWS) {
+                parallel_for(0, count, dot, 1);
+            } else {
+                for (size_t c = 0; c < count; c++) {
+                    dot(c);
+                }
+            }
+            for_row_blocks(n, [&](const size_t begin, const size_t end) {
+                for (size_t c = 0; c < count; c++) {
+                    const double* v = ws.column(c);
+                    const double coefficient = ws.pass[c];
+                    for (size_t r = begin; r < end; r++) {
+                        w[r] -= coefficient * v[r];
+                    }
+                }
+            });
+            for (size_t c = 0; c < count; c++) {
+                projections[c] += ws.pass[c];
+            }
+        }
+    }
+
+    double vector_norm(const double* w, const size_t n) {
+        double sum = 0.0;
+        for (size_t r = 0; r < n; r++) {
+            sum += w[r] * w[r];
+        }
+        return std::sqrt(sum);
+    }
+
+    /**
+     * @brief Записывает в столбец j случайный единичный вектор, ортогональный столбцам 0..j-1.
+     */
+    void random_column(KrylovWorkspace& ws, const size_t j) {
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        double* v = ws.column(j);
+        for (size_t attempt = 0; attempt < 3; attempt++) {
+            for (size_t r = 0; r < ws.n; r++) {
+                v[r] = distribution(ws.generator);
+            }
+            orthogonalize(ws, v, j, ws.projections);
+            const double length = vector_norm(v, ws.n);
+            if (length > 1e-8) {
+                for (size_t r = 0; r < ws.n; r++) {
+                    v[r] /= length;
+                }
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Продолжает разложение Арнольди A V_j = V_j H_j + f e_j^T со столбца start до m.
+     *
+     * Для симметричного случая (Ланцош) H хранится трёхдиагональной: коэффициенты вне трёх диагоналей
+     * равны нулю в точной арифметике, а полная переортогонализация сохраняет ортогональность базиса.
+     */
+    template<typename Operator>
+    void extend_factorization(KrylovWorkspace& ws, const size_t start, const bool symmetric, const Operator& apply) {
+        const size_t m = ws.m;
+        for (size_t j = start; j < m; j++) {
+            double* w = ws.w.data();
+            apply(ws.column(j), w);
+            orthogonalize(ws, w, j + 1, ws.projections);
+            const double beta = vector_norm(w, ws.n);
+
+            double scale = beta * beta;
+            for (size_t i = 0; i <= j; i++) {
+                scale += ws.projections[i] * ws.projections[i];
+            }
+            scale = std::sqrt(scale);
+
+            if (symmetric) {
+                ws.h[j * m + j] = ws.projections[j];
+            } else {
+                for (size_t i = 0; i <= j; i++) {
+                    ws.h[i * m + j] = ws.projections[i];
+                }
+            }
+
+            const bool is_breakdown = beta <= 1e-12 * scale;
+            if (j + 1 < m) {
+                if (is_breakdown) {
+                    random_column(ws, j + 1);
+                    ws.h[(j + 1) * m + j] = 0.0;
+                } else {
+                    double* next = ws.column(j + 1);
+                    for (size_t r = 0; r < ws.n; r++) {
+                        next[r] = w[r] / beta;
+                    }
+                    ws.h[(j + 1) * m + j] = beta;
+                }
+                if (symmetric) {
+                    ws.h[j * m + j + 1] = ws.h[(j + 1) * m + j];
+                }
+            } else {
+                ws.residual_norm = is_breakdown ? 0.0 : beta;
+                double* residual = ws.column(m);
+                for (size_t r = 0; r < ws.n; r++) {
+                    residual[r] = is_breakdown ? 0.0 : w[r] / beta;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Применяет к разложению сдвиги (нежелательные значения Ритца) и укорачивает его до k столбцов.
+     *
+     * @details
+     * Для каждого вещественного сдвига μ строится QR-разложение H - μI, для пары комплексно-сопряжённых
+     * сдвигов — разложение вещественной матрицы (H - μI)(H - conj(μ)I). Затем H ← Q^T H Q,
+     * V ← V Q, и новая невязка f_k = V[:, k] * H[k][k-1] + f_m * Q[m-1][k-1].
+     * Так в сжатом базисе остаются только направления, соответствующие нужным значениям.
+     */
+    void apply_shifts(KrylovWorkspace& ws, const size_t k, const bool symmetric) {
+        const size_t m = ws.m;
+        const std::vector<Complex>& shifts = ws.shifts;
+        std::vector<double>& q_total = ws.q_total;
+        std::vector<double>& shifted = ws.shifted;
+        std::vector<double>& q = ws.q;
+        std::vector<double>& product = ws.product;
+        std::fill(q_total.begin(), q_total.end(), 0.0);
+        for (size_t i = 0; i < m; i++) {
+            q_total[i * m + i] = 1.0;
+        }
+        for (size_t s = 0; s < shifts.size();) {
+            const Complex mu = shifts[s];
+            const bool is_pair = !symmetric && std::fabs(mu.imag()) > 1e-10 * std::max(1.0, std::abs(mu)) && s + 1 < shifts.size();
+            if (is_pair) {
+                for (size_t i = 0; i < m; i++) {
+                    for (size_t j = 0; j < m; j++) {
+                        double sum = 0.0;
+                        for (size_t p = 0; p < m; p++) {
+                            sum += ws.h[i * m + p] * ws.h[p * m + j];
+                        }
+                        shifted[i * m + j] = sum - 2.0 * mu.real() * ws.h[i * m + j] + (i == j ? std::norm(mu) : 0.0);
+                    }
+                }
+                s += 2;
+            } else {
+                for (size_t i = 0; i < m * m; i++) {
+                    shifted[i] = ws.h[i];
+                }
+                for (size_t i = 0; i < m; i++) {
+                    shifted[i * m + i] -= mu.real();
+                }
+                s += 1;
+            }
+            householder_q(shifted, m, q, ws.reflector);
+
+            // H ← Q^T H Q
+            for (size_t i = 0; i < m; i++) {
+                for (size_t j = 0; j < m; j++) {
+                    double sum = 0.0;
+                    for (size_t p = 0; p < m; p++) {
+                        sum += ws.h[i * m + p] * q[p * m + j];
+                    }
+                    product[i * m + j] = sum;
+                }
+            }
+            for (size_t i = 0; i < m; i++) {
+                for (size_t j = 0; j < m; j++) {
+                    double sum = 0.0;
+                    for (size_t p = 0; p < m; p++) {
+                        sum += q[p * m + i] * product[p * m + j];
+                    }
+                    ws.h[i * m + j] = sum;
+                }
+            }
+            for (size_t i = 0; i < m; i++) {
+                for (size_t j = 0; j + 1 < i; j++) {
+                    ws.h[i * m + j] = 0.0;
+                }
+            }
+            if (symmetric) {
+                for (size_t i = 0; i < m; i++) {
+                    for (size_t j = i + 2; j < m; j++) {
+                        ws.h[i * m + j] = 0.0;
+                    }
+                    if (i + 1 < m) {
+                        const double off = 0.5 * (ws.h[i * m + i + 1] + ws.h[(i + 1) * m + i]);
+                        ws.h[i * m + i + 1] = off;
+                        ws.h[(i + 1) * m + i] = off;
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < m; i++) {
+                for (size_t j = 0; j < m; j++) {
+                    double sum = 0.0;
+                    for (size_t p = 0; p < m; p++) {
+                        sum += q_total[i * m + p] * q[p * m + j];
+                    }
+                    product[i * m + j] = sum;
+                }
+            }
+            q_total.swap(product);
+        }
+
+        // V[:, 0..k] ← V Q[:, 0..k]
+        const size_t n = ws.n;
+        for_row_blocks(n, [&](const size_t begin, const size_t end) {
+            for (size_t c = 0; c <= k; c++) {
+                double* target = ws.buffer.data() + c * n;
+                std::fill(target + begin, target + end, 0.0);
+                for (size_t p = 0; p < m; p++) {
+                    const double coefficient = q_total[p * m + c];
+                    const double* source = ws.column(p);
+                    for (size_t r = begin; r < end; r++) {
+                        target[r] += coefficient * source[r];
+                    }
+                }
+            }
+        });
+
+        const double coupling = ws.h[k * m + k - 1];
+        const double tail = ws.residual_norm * q_total[(m - 1) * m + k - 1];
+        double* residual = ws.column(m);
+        double* w = ws.w.data();
+        for (size_t r = 0; r < n; r++) {
+            w[r] = ws.buffer[k * n + r] * coupling + residual[r] * tail;
+        }
+        std::copy(ws.buffer.begin(), ws.buffer.begin() + k * n, ws.basis.begin());
+
+        for (size_t i = 0; i < m; i++) {
+            for (size_t j = 0; j < m; j++) {
+                if (i >= k || j >= k) {
+                    ws.h[i * m + j] = 0.0;
+                }
+            }
+        }
+        const double beta = vector_norm(w, n);
+        if (beta <= 1e-12 * std::max(1.0, std::fabs(coupling) + std::fabs(tail))) {
+            random_column(ws, k);
+            ws.h[k * m + k - 1] = 0.0;
+        } else {
+            double* next = ws.column(k);
+            for (size_t r = 0; r < n; r++) {
+                next[r] = w[r] / beta;
+            }
+            ws.h[k * m + k - 1] = beta;
+        }
+        if (symmetric) {
+            ws.h[(k - 1) * m + k] = ws.h[k * m + k - 1];
+        }
+    }
+
+    /**
+     * @brief Общая часть методов Ланцоша и Арнольди (неявные перезапуски с точными сдвигами).
+     *
+     * @details
+     * **Алгоритм:**
+     * 1. Строим разложение Арнольди размера m, используя только умножение матрицы на вектор (или сдвиг с обращением).
+     * 2. Находим собственные пары малой матрицы H (значения Ритца) и упорядочиваем их: первые k — искомые.
+     * 3. Оценка невязки пары Ритца (θ, y): ||A x - θ x|| = ||f|| * |y[m-1]|. Если все k пар сошлись — готово.
+     * 4. Иначе остальные m - k значений используются как сдвиги (`apply_shifts`), разложение сжимается
+     *    до k столбцов и снова дополняется до m. Вся рабочая память (`KrylovWorkspace`) выделяется
+     *    один раз до первой итерации и при перезапусках не перераспределяется.
+     *
+     * Стоимость одного перезапуска — (m - k) умножений на вектор, O(nnz) каждое, плюс O(n * m^2) на ортогонализацию.
+     */
+    EigenResult implicitly_restarted(const Matrix& matrix, const EigenOptions& options, const bool symmetric) {
+        EigenResult result;
+        const size_t n = matrix.get_count_rows();
+        if (!matrix.is_square_matrix() || n == 0) {
+            std::cout << "[LOG] [ERROR] Eigenvalues are defined only for square matrices!" << std::endl;
+            return result;
+        }
+        if (options.count == 0 || options.count > n) {
+            std::cout << "[LOG] [ERROR] Invalid number of eigenvalues requested!" << std::endl;
+            return result;
+        }
+        const size_t count = options.count;
+        const bool is_shift_invert = static_cast<bool>(options.shift_invert);
+
+        const size_t minimum = count + (symmetric ? 1 : 2);
+        const size_t m = std::min(n, std::max(options.subspace == 0 ? std::max<size_t>(2 * count + 1, 20) : options.subspace, minimum));
+        KrylovWorkspace ws;
+        ws.allocate(n, m);
+        std::vector<Complex>& ritz_values = ws.ritz_values;
+        std::vector<Complex>& ritz_vectors = ws.ritz_vectors;
+        std::vector<size_t>& order = ws.order;
+
+        const auto apply = [&](const double* input, double* output) {
+            if (is_shift_invert) {
+                options.shift_invert(input, output);
+            } else {
+                matrix.multiply_vector(input, output);
+            }
+        };
+        // Порядок значений Ритца: сначала искомые
+        const auto is_better = [&](const Complex& a, const Complex& b) {
+            double key_a, key_b;
+            if (is_shift_invert) {
+                key_a = std::abs(a);
+                key_b = std::abs(b);
+            } else if (symmetric) {
+                key_a = options.target == EigenTarget::Largest ? a.real() : -a.real();
+                key_b = options.target == EigenTarget::Largest ? b.real() : -b.real();
+            } else {
+                key_a = options.target == EigenTarget::Largest ? std::abs(a) : -std::abs(a);
+                key_b = options.target == EigenTarget::Largest ? std::abs(b) : -std::abs(b);
+            }
+            if (key_a != key_b) return key_a > key_b;
+            if (a.real() != b.real()) return a.real() > b.real();
+            return a.imag() > b.imag();
+        };
+
+        random_column(ws, 0);
+        extend_factorization(ws, 0, symmetric, apply);
+
+        while (true) {
+            bool is_computed;
+            if (symmetric) {
+                symmetric_eigen(ws);
+                is_computed = true;
+            } else {
+                is_computed = hessenberg_eigen(ws);
+            }
+            if (!is_computed) {
+                std::cout << "[LOG] [ERROR] QR iteration for Ritz values did not converge!" << std::endl;
+                return result;
+            }
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+                return is_better(ritz_values[a], ritz_values[b]);
+            });
+
+            size_t count_converged = 0;
+            for (size_t i = 0; i < count; i++) {
+                const size_t idx = order[i];
+                const double residual = ws.residual_norm * std::abs(ritz_vectors[(m - 1) * m + idx]);
+                const double scale = std::max(std::abs(ritz_values[idx]), std::pow(EPSILON, 2.0 / 3.0));
+                count_converged += residual <= options.tolerance * scale;
+            }
+
+            // Не разделяем пару комплексно-сопряжённых значений между искомыми и сдвигами
+            size_t keep = count;
+            if (!symmetric && keep < m) {
+                const Complex last = ritz_values[order[keep - 1]];
+                if (std::fabs(last.imag()) > 1e-10 * std::max(1.0, std::abs(last)) &&
+                    std::abs(ritz_values[order[keep]] - std::conj(last)) <= 1e-8 * std::max(1.0, std::abs(last))) {
+                    keep++;
+                }
+            }
+
+            if (count_converged == count || result.restarts >= options.max_restarts || keep >= m) {
+                result.converged = count_converged == count;
+                break;
+            }
+
+            ws.shifts.clear();
+            for (size_t i = keep; i < m; i++) {
+                ws.shifts.push_back(ritz_values[order[i]]);
+            }
+            apply_shifts(ws, keep, symmetric);
+            extend_factorization(ws, keep, symmetric, apply);
+            result.restarts++;
+        }
+
+        result.values.resize(count);
+        result.values_imag.resize(count);
+        result.vectors.assign(count, std::vector(n, 0.0));
+        result.vectors_imag.assign(count, std::vector(n, 0.0));
+        for (size_t i = 0; i < count; i++) {
+            const size_t idx = order[i];
+            Complex value = ritz_values[idx];
+            if (is_shift_invert) {
+                value = options.shift + 1.0 / value;
+            }
+            result.values[i] = value.real();
+            result.values_imag[i] = symmetric ? 0.0 : value.imag();
+            for_row_blocks(n, [&](const size_t begin, const size_t end) {
+                for (size_t r = begin; r < end; r++) {
+                    Complex sum = 0.0;
+                    for (size_t p = 0; p < m; p++) {
+                        sum += ws.basis[p * n + r] * ritz_vectors[p * m + idx];
+                    }
+                    result.vectors[i][r] = sum.real();
+                    result.vectors_imag[i][r] = sum.imag();
+                }
+            });
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Находит k собственных пар симметричной матрицы неявно перезапускаемым методом Ланцоша.
+ * @param matrix Симметричная квадратная матрица в CSR-формате (симметричность не проверяется).
+ * @param options Количество пар, какие значения искать, допуск и необязательный сдвиг с обращением.
+ * @return Собственные значения в порядке `options.target` (ближайшие к сдвигу — при сдвиге с обращением)
+ *         и соответствующие единичные собственные векторы.
+ *
+ * @details
+ * **Математическое обоснование:**
+ * Для симметричной A проекция на подпространство Крылова K_m(A, v) = span{v, Av, ..., A^{m-1}v}
+ * трёхдиагональна: T = V^T A V. Собственные значения T (значения Ритца) быстро сходятся к крайним
+ * собственным значениям A. Матрица используется только через SpMV, поэтому память — O(nnz + n * m).
+ */
+EigenResult lanczos_eigenpairs(const Matrix& matrix, const EigenOptions& options) {
+    return implicitly_restarted(matrix, options, true);
+}
+
+/**
+ * @brief Находит k собственных пар произвольной квадратной матрицы неявно перезапускаемым методом Арнольди.
+ * @param matrix Квадратная матрица в CSR-формате.
+ * @param options Количество пар, какие значения искать (по модулю), допуск и необязательный сдвиг с обращением.
+ * @return Собственные значения и векторы; у комплексных пар заполнены мнимые части.
+ *
+ * @details
+ * **Математическое обоснование:**
+ * В отличие от Ланцоша проекция H = V^T A V — верхняя хессенбергова матрица, а её собственные
+ * значения могут быть комплексными. Наименьшие по модулю значения сходятся медленно —
+ * для них лучше задать сдвиг с обращением около нуля.
+ */
+EigenResult arnoldi_eigenpairs(const Matrix& matrix, const EigenOptions& options) {
+    return implicitly_restarted(matrix, options, false);
+}
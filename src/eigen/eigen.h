@@ -0,0 +1,50 @@
+#pragma once
+
+#include "matrix.h"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Какие собственные значения искать.
+ *
+ * Для симметричных матриц (Ланцош) — наибольшие или наименьшие алгебраически,
+ * для произвольных (Арнольди) — наибольшие или наименьшие по модулю.
+ */
+enum class EigenTarget {
+    Largest,
+    Smallest
+};
+
+/**
+ * @brief Параметры итерационного поиска собственных пар.
+ */
+struct EigenOptions {
+    size_t count = 1;
+    EigenTarget target = EigenTarget::Largest;
+    // Размер подпространства Крылова (0 — выбрать автоматически, не меньше 2 * count + 1)
+    size_t subspace = 0;
+    size_t max_restarts = 300;
+    double tolerance = 1e-10;
+
+    // Сдвиг с обращением: если задан, shift_invert(x, y) должен вычислять y = (A - shift * I)^{-1} x.
+    // Тогда находятся собственные значения, ближайшие к shift, а `target` не используется.
+    std::function<void(const double* input, double* output)> shift_invert;
+    double shift = 0.0;
+};
+
+/**
+ * @brief Найденные собственные пары. Для комплексных пар заполняются мнимые части (у Ланцоша они нулевые).
+ */
+struct EigenResult {
+    std::vector<double> values;
+    std::vector<double> values_imag;
+    std::vector<std::vector<double>> vectors;
+    std::vector<std::vector<double>> vectors_imag;
+    size_t restarts = 0;
+    bool converged = false;
+};
+
+EigenResult lanczos_eigenpairs(const Matrix& matrix, const EigenOptions& options);
+EigenResult arnoldi_eigenpairs(const Matrix& matrix, const EigenOptions& options);
@@ -0,0 +1,100 @@
+#include "test_eigen.h"
+#include "eigen.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Тест метода Ланцоша на матрице одномерного лапласиана (значения известны аналитически)
+void test_lanczos_eigenpairs() {
+    constexpr size_t n = 100;
+    std::vector input_matrix(n, std::vector(n, 0.0));
+    for (size_t i = 0; i < n; i++) {
+        input_matrix[i][i] = 2;
+        if (i + 1 < n) {
+            input_matrix[i][i + 1] = -1;
+            input_matrix[i + 1][i] = -1;
+        }
+    }
+    const Matrix matrix(input_matrix);
+
+    EigenOptions options;
+    options.count = 3;
+    for (const EigenTarget target : {EigenTarget::Largest, EigenTarget::Smallest}) {
+        options.target = target;
+        const EigenResult result = lanczos_eigenpairs(matrix, options);
+        CU_ASSERT_TRUE(result.converged);
+        CU_ASSERT_EQUAL(result.values.size(), 3);
+        for (size_t i = 0; i < result.values.size(); i++) {
+            const size_t k = target == EigenTarget::Largest ? n - i : i + 1;
+            const double expected = 2.0 - 2.0 * std::cos(k * std::acos(-1.0) / (n + 1));
+            CU_ASSERT_DOUBLE_EQUAL(result.values[i], expected, 1e-8);
+
+            // Проверяем ||A x - λ x||
+            std::vector<double> product(n);
+            matrix.multiply_vector(result.vectors[i].data(), product.data());
+            double residual = 0.0;
+            for (size_t r = 0; r < n; r++) {
+                residual = std::max(residual, std::fabs(product[r] - result.values[i] * result.vectors[i][r]));
+            }
+            CU_ASSERT_TRUE(residual < 1e-6);
+        }
+    }
+}
+
+// Тест метода Арнольди: несимметричная матрица с парой комплексно-сопряжённых значений 30 ± 4i
+void test_arnoldi_eigenpairs() {
+    constexpr size_t n = 40;
+    std::vector input_matrix(n, std::vector(n, 0.0));
+    for (size_t i = 0; i < n - 2; i++) {
+        input_matrix[i][i] = static_cast<double>(i + 1) / 2;
+        input_matrix[i][i + 1] = 1;
+    }
+    input_matrix[n - 2][n - 2] = 30;
+    input_matrix[n - 2][n - 1] = 4;
+    input_matrix[n - 1][n - 2] = -4;
+    input_matrix[n - 1][n - 1] = 30;
+    const Matrix matrix(input_matrix);
+
+    EigenOptions options;
+    options.count = 3;
+    const EigenResult result = arnoldi_eigenpairs(matrix, options);
+    CU_ASSERT_TRUE(result.converged);
+    CU_ASSERT_EQUAL(result.values.size(), 3);
+    CU_ASSERT_DOUBLE_EQUAL(result.values[0], 30.0, 1e-8);
+    CU_ASSERT_DOUBLE_EQUAL(std::fabs(result.values_imag[0]), 4.0, 1e-8);
+    CU_ASSERT_DOUBLE_EQUAL(result.values[1], 30.0, 1e-8);
+    CU_ASSERT_DOUBLE_EQUAL(result.values_imag[0] + result.values_imag[1], 0.0, 1e-8);
+    CU_ASSERT_DOUBLE_EQUAL(result.values[2], 19.0, 1e-8);
+    CU_ASSERT_DOUBLE_EQUAL(result.values_imag[2], 0.0, 1e-8);
+}
+
+// Тест сдвига с обращением: ищем значение, ближайшее к 10.3, у верхней треугольной матрицы
+void test_arnoldi_shift_invert() {
+    constexpr size_t n = 30;
+    constexpr double shift = 10.3;
+    std::vector input_matrix(n, std::vector(n, 0.0));
+    std::vector shifted_matrix(n, std::vector(n, 0.0));
+    for (size_t i = 0; i < n; i++) {
+        input_matrix[i][i] = static_cast<double>(i + 1);
+        if (i + 1 < n) {
+            input_matrix[i][i + 1] = 0.5;
+        }
+        shifted_matrix[i] = input_matrix[i];
+        shifted_matrix[i][i] -= shift;
+    }
+    const Matrix matrix(input_matrix);
+    const Matrix shifted(shifted_matrix);
+
+    EigenOptions options;
+    options.count = 2;
+    options.shift = shift;
+    options.shift_invert = [&shifted](const double* input, double* output) {
+        const std::vector<double> solution = shifted.solve_upper_triangular(std::vector(input, input + n));
+        std::copy(solution.begin(), solution.end(), output);
+    };
+    const EigenResult result = arnoldi_eigenpairs(matrix, options);
+    CU_ASSERT_TRUE(result.converged);
+    CU_ASSERT_EQUAL(result.values.size(), 2);
+    CU_ASSERT_DOUBLE_EQUAL(result.values[0], 10.0, 1e-8);
+    CU_ASSERT_DOUBLE_EQUAL(result.values[1], 11.0, 1e-8);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+
+void test_lanczos_eigenpairs();
+void test_arnoldi_eigenpairs();
+void test_arnoldi_shift_invert();
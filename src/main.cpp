@@ -1,11 +1,50 @@
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <thread>
 
+#include "batch.h"
 #include "matrix.h"
+#include "test_batch.h"
+#include "test_eigen.h"
 #include "test_matrix.h"
 #include "utility_func.h"
 
-int main() {
+static int print_usage() {
+    std::cerr << "Usage: lin-alg-lib [--batch <manifest> [--output <file>] [--threads <N>]]\n"
+              << "  N: 0 (one per core, default) up to 16 threads per core\n";
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    // Пакетный режим: операции читаются из манифеста, интерактивный ввод не используется
+    if (argc > 1) {
+        std::string manifest_path, output_path;
+        size_t count_threads = 0;
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            if (i + 1 >= argc) return print_usage();
+            if (arg == "--batch") {
+                manifest_path = argv[++i];
+            } else if (arg == "--output") {
+                output_path = argv[++i];
+            } else if (arg == "--threads") {
+                const char* value = argv[++i];
+                if (value[0] < '0' || value[0] > '9') return print_usage();
+                char* end;
+                count_threads = std::strtoul(value, &end, 10);
+                const size_t max_threads = 16 * std::max(1u, std::thread::hardware_concurrency());
+                if (*end != '\0' || count_threads > max_threads) return print_usage();
+            } else {
+                return print_usage();
+            }
+        }
+        if (manifest_path.empty()) return print_usage();
+        return run_batch_mode(manifest_path, output_path, count_threads);
+    }
+
 #ifndef NDEBUG
 #ifdef _WIN32
     enable_ansi_support();
@@ -30,6 +69,19 @@ int main() {
         !CU_add_test(suite, "test_operator_matrix_multiply", test_matrix_multiplication) ||
         !CU_add_test(suite, "test_operator_add", test_matrix_addition) ||
         !CU_add_test(suite, "test_csr_to_basic", test_csr_to_basic) ||
+        !CU_add_test(suite, "test_csr_to_dense_buffer", test_csr_to_dense_buffer) ||
+        !CU_add_test(suite, "test_constructor_and_csr_large", test_constructor_and_csr_large) ||
+        !CU_add_test(suite, "test_constructor_too_many_nonzeros", test_constructor_too_many_nonzeros) ||
+        !CU_add_test(suite, "test_solve_lower_triangular", test_solve_lower_triangular) ||
+        !CU_add_test(suite, "test_solve_upper_triangular", test_solve_upper_triangular) ||
+        !CU_add_test(suite, "test_solve_triangular_concurrent", test_solve_triangular_concurrent) ||
+        !CU_add_test(suite, "test_solve_triangular_wide_levels", test_solve_triangular_wide_levels) ||
+        !CU_add_test(suite, "test_batch_manifest_errors", test_batch_manifest_errors) ||
+        !CU_add_test(suite, "test_batch_run", test_batch_run) ||
+        !CU_add_test(suite, "test_batch_invalid_operands", test_batch_invalid_operands) ||
+        !CU_add_test(suite, "test_lanczos_eigenpairs", test_lanczos_eigenpairs) ||
+        !CU_add_test(suite, "test_arnoldi_eigenpairs", test_arnoldi_eigenpairs) ||
+        !CU_add_test(suite, "test_arnoldi_shift_invert", test_arnoldi_shift_invert) ||
         !CU_add_test(suite, "test_constructor_and_csr", test_constructor_and_csr)) {
         CU_cleanup_registry();
         std::cerr << RED << "Error adding tests!" << RESET << std::endl;
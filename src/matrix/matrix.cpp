@@ -1,5 +1,8 @@
 #include "matrix.h"
+#include "parallel.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <unordered_map>
 
@@ -234,12 +237,97 @@ Matrix Matrix::operator+(const Matrix &other) const {
             }
         }
 
+        if (result_columns.size() > MAX_NONZEROS) {
+            std::cout << "[LOG] [ERROR] Too many nonzero elements for the CSR format!" << std::endl;
+            return Matrix(std::vector<std::vector<double>>{{0}});
+        }
         result_row_offsets.push_back(result_columns.size());
     }
     return Matrix(result_values, result_columns, result_row_offsets,
         this->get_count_rows() == this->get_count_cols(), this->get_count_rows(), this->get_count_cols());
 }
 
+/**
+ * @brief Умножает матрицу на вектор (SpMV): output = A * input.
+ * @param input Вектор длины `get_count_cols()`.
+ * @param output Вектор длины `get_count_rows()`. Не должен пересекаться с `input`.
+ *
+ * @details
+ * **Математический принцип:**
+ * output[j] = Σ A[j][i] * input[i] — в CSR достаточно пройти только ненулевые элементы строки j,
+ * поэтому стоимость пропорциональна количеству ненулевых элементов. Строки обрабатываются параллельно,
+ * если их достаточно много, чтобы окупить запуск потоков.
+ */
+void Matrix::multiply_vector(const double* input, double* output) const {
+    parallel_for(0, _count_rows, [&](const size_t j) {
+        double sum = 0.0;
+        const uint16_t start_idx = _row_ptr[j];
+        const uint16_t end_idx = _row_ptr[j + 1];
+        for (uint16_t i = start_idx; i < end_idx; i++) {
+            sum += _values[i] * input[_column_idx[i]];
+        }
+        output[j] = sum;
+    }, 8192);
+}
+
+/**
+ * @brief Проверяет, что матрица нижняя треугольная (все ненулевые элементы не выше главной диагонали).
+ */
+bool Matrix::is_lower_triangular() const {
+    for (uint16_t j = 0; j < _count_rows; j++) {
+        for (uint16_t i = _row_ptr[j]; i < _row_ptr[j + 1]; i++) {
+            if (_column_idx[i] > j) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Проверяет, что матрица верхняя треугольная (все ненулевые элементы не ниже главной диагонали).
+ */
+bool Matrix::is_upper_triangular() const {
+    for (uint16_t j = 0; j < _count_rows; j++) {
+        for (uint16_t i = _row_ptr[j]; i < _row_ptr[j + 1]; i++) {
+            if (_column_idx[i] < j) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Решает систему L * x = rhs, где L — нижняя треугольная часть матрицы (прямая подстановка).
+ * @param rhs Правая часть системы (размер равен числу строк).
+ * @param unit_diagonal Если true, диагональ считается единичной и не читается (как у множителя L в ILU/LU).
+ * @return Решение x или пустой вектор, если система не может быть решена.
+ *
+ * @details
+ * **Математическое обоснование:**
+ * x[i] = (rhs[i] - Σ L[i][j] * x[j]) / L[i][i] по j < i.
+ * Элементы выше диагонали игнорируются, поэтому можно передавать матрицу, хранящую L и U вместе.
+ *
+ * **Алгоритм:**
+ * 1. Берём (или строим при первом вызове) разбиение строк на уровни зависимостей.
+ * 2. Уровни обрабатываются по очереди, строки внутри одного уровня — параллельно
+ *    (потоки создаются один раз на вызов, между уровнями — барьер, узкие уровни считает один поток).
+ */
+std::vector<double> Matrix::solve_lower_triangular(const std::vector<double>& rhs, const bool unit_diagonal) const {
+    return _solve_triangular(rhs, true, unit_diagonal);
+}
+
+/**
+ * @brief Решает систему U * x = rhs, где U — верхняя треугольная часть матрицы (обратная подстановка).
+ * @param rhs Правая часть системы (размер равен числу строк).
+ * @param unit_diagonal Если true, диагональ считается единичной и не читается.
+ * @return Решение x или пустой вектор, если система не может быть решена.
+ *
+ * @details
+ * x[i] = (rhs[i] - Σ U[i][j] * x[j]) / U[i][i] по j > i. Элементы ниже диагонали игнорируются.
+ * Разбиение на уровни кэшируется так же, как в `solve_lower_triangular`.
+ */
+std::vector<double> Matrix::solve_upper_triangular(const std::vector<double>& rhs, const bool unit_diagonal) const {
+    return _solve_triangular(rhs, false, unit_diagonal);
+}
+
 /**
  * @brief Преобразует базовый формат матрицы в CSR-формат.
  * @param input_matrix Базовая матрица (двумерный вектор).
@@ -257,20 +345,45 @@ Matrix Matrix::operator+(const Matrix &other) const {
  *   - `_values`: [5, 8, 3, 6]
  *   - `_column_idx`: [0, 1, 0, 2]
  *   - `_row_ptr`: [0, 1, 2, 4]
+ *
+ * **Алгоритм (два прохода):**
+ * 1. Параллельно по строкам считаем количество ненулевых элементов.
+ * 2. Префиксной суммой (в `size_t`) превращаем счётчики в границы строк и один раз выделяем `_values` и `_column_idx`.
+ *    Если ненулевых элементов больше `MAX_NONZEROS`, их индексы не помещаются в `_row_ptr`:
+ *    выводится ошибка, и матрица остаётся нулевой.
+ * 3. Параллельно по строкам заполняем значения: каждая строка пишет только в свой диапазон `_row_ptr[j]..._row_ptr[j + 1]`.
  */
 void Matrix::_transform_basic_to_csr(const std::vector<std::vector<double>>& input_matrix) {
     if (input_matrix.empty()) return;
-    _row_ptr.push_back(0);
-    for (uint16_t j = 0; j < input_matrix.size(); j++) {
-        const uint16_t row_size = input_matrix[j].size();
-        for (uint16_t i = 0; i < row_size; i++) {
-            if (input_matrix[j][i] != 0) {
-                _values.push_back(input_matrix[j][i]);
-                _column_idx.push_back(i);
+    const size_t count_rows = input_matrix.size();
+    std::vector<size_t> row_offsets(count_rows + 1, 0);
+    parallel_for(0, count_rows, [&](const size_t j) {
+        row_offsets[j + 1] = _count_nonzeros(input_matrix[j].data(), input_matrix[j].size());
+    });
+    for (size_t j = 0; j < count_rows; j++) {
+        row_offsets[j + 1] += row_offsets[j];
+    }
+    _row_ptr.assign(count_rows + 1, 0);
+    if (row_offsets[count_rows] > MAX_NONZEROS) {
+        std::cout << "[LOG] [ERROR] Too many nonzero elements for the CSR format!" << std::endl;
+        return;
+    }
+    for (size_t j = 0; j <= count_rows; j++) {
+        _row_ptr[j] = row_offsets[j];
+    }
+    _values.resize(row_offsets[count_rows]);
+    _column_idx.resize(row_offsets[count_rows]);
+    parallel_for(0, count_rows, [&](const size_t j) {
+        const std::vector<double>& row = input_matrix[j];
+        size_t position = row_offsets[j];
+        for (size_t i = 0; i < row.size(); i++) {
+            if (row[i] != 0) {
+                _values[position] = row[i];
+                _column_idx[position] = i;
+                position++;
             }
         }
-        _row_ptr.push_back(_values.size());
-    }
+    });
 }
 
 /**
@@ -285,16 +398,169 @@ void Matrix::_transform_basic_to_csr(const std::vector<std::vector<double>>& inp
  */
 std::vector<std::vector<double>> Matrix::_transform_csr_to_basic() const {
     std::vector output_matrix(_count_rows, std::vector(_count_cols, 0.0));
-    for (uint16_t j = 0; j < _count_rows; j++) {
+    parallel_for(0, _count_rows, [&](const size_t j) {
         const uint16_t start_idx = _row_ptr[j];
         const uint16_t end_idx = _row_ptr[j + 1];
         for (uint16_t i = start_idx; i < end_idx; i++) {
             output_matrix[j][_column_idx[i]] = _values[i];
         }
-    }
+    });
     return output_matrix;
 }
 
+/**
+ * @brief Записывает матрицу в плотном виде в непрерывный буфер вызывающей стороны (построчно).
+ * @param output Буфер размером не меньше `leading_dim * get_count_rows()` элементов.
+ * @param leading_dim Шаг между началами соседних строк в буфере (не меньше `get_count_cols()`).
+ *
+ * @details
+ * Элемент A[j][i] записывается в `output[j * leading_dim + i]`. В отличие от `get_matrix()`,
+ * не выделяет память под каждую строку, поэтому подходит для передачи данных в плотные библиотеки.
+ * Элементы строки за пределами `get_count_cols()` (хвост до `leading_dim`) не изменяются.
+ */
+void Matrix::get_matrix(double* output, const size_t leading_dim) const {
+    if (leading_dim < _count_cols) {
+        std::cout << "[LOG] [ERROR] Leading dimension is less than the number of columns!" << std::endl;
+        return;
+    }
+    parallel_for(0, _count_rows, [&](const size_t j) {
+        double* row = output + j * leading_dim;
+        std::fill(row, row + _count_cols, 0.0);
+        const uint16_t start_idx = _row_ptr[j];
+        const uint16_t end_idx = _row_ptr[j + 1];
+        for (uint16_t i = start_idx; i < end_idx; i++) {
+            row[_column_idx[i]] = _values[i];
+        }
+    });
+}
+
+/**
+ * @brief Считает количество ненулевых элементов в строке.
+ * @param row Указатель на начало строки.
+ * @param size Длина строки.
+ * @return Количество ненулевых элементов.
+ *
+ * @details
+ * Цикл без ветвлений: результат сравнения с нулём прибавляется к счётчику, поэтому
+ * неравномерное расположение нулей не приводит к ошибкам предсказания переходов.
+ */
+size_t Matrix::_count_nonzeros(const double* row, const size_t size) {
+    size_t count = 0;
+    for (size_t i = 0; i < size; i++) {
+        count += row[i] != 0.0;
+    }
+    return count;
+}
+
+/**
+ * @brief Возвращает разбиение строк на уровни зависимостей для треугольной подстановки.
+ * @param lower true — для нижней треугольной части, false — для верхней.
+ * @return Ссылка на закэшированное разбиение.
+ *
+ * @details
+ * Разбиение строится при первом обращении ровно один раз (std::call_once), поэтому решать системы
+ * с одной и той же матрицей можно одновременно из нескольких потоков.
+ */
+const Matrix::LevelSchedule& Matrix::_get_level_schedule(const bool lower) const {
+    LevelCache& cache = *_levels;
+    LevelSchedule& schedule = lower ? cache.lower : cache.upper;
+    std::call_once(lower ? cache.lower_flag : cache.upper_flag, [&] { _build_level_schedule(lower, schedule); });
+    return schedule;
+}
+
+/**
+ * @brief Строит разбиение строк на уровни зависимостей для треугольной подстановки.
+ * @param lower true — для нижней треугольной части, false — для верхней.
+ * @param schedule Результат.
+ *
+ * @details
+ * **Математическое обоснование:**
+ * Строка i нижней треугольной системы зависит от строк j < i, для которых L[i][j] != 0.
+ * Уровень строки: level[i] = 1 + max(level[j]) по всем таким j (0, если зависимостей нет).
+ * Строки одного уровня не зависят друг от друга и могут вычисляться одновременно.
+ * Для верхней треугольной системы строки обходятся снизу вверх, зависимости — по j > i.
+ *
+ * **Алгоритм:**
+ * 1. Вычисляем уровень каждой строки по `_row_ptr` и `_column_idx`.
+ * 2. Сортировкой подсчётом раскладываем строки по уровням: `level_ptr` — границы уровней в `rows`.
+ *
+ * Результат зависит только от структуры матрицы, поэтому строится один раз и переиспользуется
+ * для любых правых частей (в том числе после умножения на скаляр).
+ */
+void Matrix::_build_level_schedule(const bool lower, LevelSchedule& schedule) const {
+    std::vector<uint16_t> level(_count_rows, 0);
+    uint16_t count_levels = 0;
+    for (uint16_t step = 0; step < _count_rows; step++) {
+        const uint16_t j = lower ? step : _count_rows - 1 - step;
+        uint16_t row_level = 0;
+        for (uint16_t i = _row_ptr[j]; i < _row_ptr[j + 1]; i++) {
+            const uint16_t col = _column_idx[i];
+            if (lower ? col < j : col > j) {
+                row_level = std::max<uint16_t>(row_level, level[col] + 1);
+            }
+        }
+        level[j] = row_level;
+        count_levels = std::max<uint16_t>(count_levels, row_level + 1);
+    }
+
+    schedule.level_ptr.assign(count_levels + 1, 0);
+    for (uint16_t j = 0; j < _count_rows; j++) {
+        schedule.level_ptr[level[j] + 1]++;
+    }
+    for (uint16_t l = 0; l < count_levels; l++) {
+        schedule.level_ptr[l + 1] += schedule.level_ptr[l];
+    }
+    schedule.rows.resize(_count_rows);
+    std::vector<uint16_t> position(schedule.level_ptr.begin(), schedule.level_ptr.end() - 1);
+    for (uint16_t j = 0; j < _count_rows; j++) {
+        schedule.rows[position[level[j]]++] = j;
+    }
+}
+
+/**
+ * @brief Общая реализация прямой и обратной подстановки по уровням зависимостей.
+ * @param rhs Правая часть системы.
+ * @param lower true — нижняя треугольная система, false — верхняя.
+ * @param unit_diagonal Считать ли диагональ единичной.
+ * @return Решение или пустой вектор при ошибке (неквадратная матрица, неверный размер, нулевая диагональ).
+ */
+std::vector<double> Matrix::_solve_triangular(const std::vector<double>& rhs, const bool lower, const bool unit_diagonal) const {
+    if (!_isSquareMatrix) {
+        std::cout << "[LOG] [ERROR] Triangular solve requires a square matrix!" << std::endl;
+        return {};
+    }
+    if (rhs.size() != _count_rows) {
+        std::cout << "[LOG] [ERROR] Right-hand side size does not match the matrix!" << std::endl;
+        return {};
+    }
+    const LevelSchedule& schedule = _get_level_schedule(lower);
+    std::vector<double> solution(_count_rows, 0.0);
+    std::atomic<bool> is_singular = false;
+    parallel_for_levels(schedule.level_ptr, [&](const size_t k) {
+        const uint16_t j = schedule.rows[k];
+        double sum = rhs[j];
+        double diagonal = unit_diagonal ? 1.0 : 0.0;
+        for (uint16_t i = _row_ptr[j]; i < _row_ptr[j + 1]; i++) {
+            const uint16_t col = _column_idx[i];
+            if (lower ? col < j : col > j) {
+                sum -= _values[i] * solution[col];
+            } else if (col == j && !unit_diagonal) {
+                diagonal = _values[i];
+            }
+        }
+        if (diagonal == 0.0) {
+            is_singular.store(true, std::memory_order_relaxed);
+            return;
+        }
+        solution[j] = sum / diagonal;
+    });
+    if (is_singular) {
+        std::cout << "[LOG] [ERROR] Triangular matrix has a zero on the diagonal!" << std::endl;
+        return {};
+    }
+    return solution;
+}
+
 /**
  * @brief Вычисляет определитель матрицы рекурсивным методом разложения по строке.
  *
@@ -1,15 +1,23 @@
 #pragma once
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
 
 class Matrix {
 public:
+    // Индексы в `_row_ptr` хранятся в uint16_t, поэтому ненулевых элементов не больше этого значения
+    static constexpr size_t MAX_NONZEROS = std::numeric_limits<uint16_t>::max();
+
     explicit Matrix(const std::vector<std::vector<double>>& input_matrix);
     explicit Matrix(const std::vector<double>& values, const std::vector<uint16_t>& column_idx, const std::vector<uint16_t>& row_ptr, bool isSquareMatrix, uint16_t rows, uint16_t cols);
     ~Matrix() = default;
 
     std::vector<std::vector<double>> get_matrix() const { return _transform_csr_to_basic(); }
+    void get_matrix(double* output, size_t leading_dim) const;
     std::vector<double> get_values() const { return _values; }
     std::vector<uint16_t> get_column_idx() const { return _column_idx; }
     std::vector<uint16_t> get_row_ptr() const { return _row_ptr; }
@@ -18,6 +26,8 @@ public:
     uint16_t get_count_cols() const { return _count_cols; }
 
     bool is_square_matrix() const { return _isSquareMatrix; }
+    bool is_lower_triangular() const;
+    bool is_upper_triangular() const;
 
     double get_trace() const;
     double get_element(int row, int col) const;
@@ -26,10 +36,34 @@ public:
     Matrix operator*(double scalar);
     Matrix operator*(const Matrix& other) const;
     Matrix operator+(const Matrix& other) const;
+
+    void multiply_vector(const double* input, double* output) const;
+
+    std::vector<double> solve_lower_triangular(const std::vector<double>& rhs, bool unit_diagonal = false) const;
+    std::vector<double> solve_upper_triangular(const std::vector<double>& rhs, bool unit_diagonal = false) const;
 private:
+    struct LevelSchedule {
+        std::vector<uint16_t> level_ptr;
+        std::vector<uint16_t> rows;
+    };
+
+    // Разбиения зависят только от структуры, поэтому копии матрицы разделяют один кэш
+    struct LevelCache {
+        std::once_flag lower_flag;
+        std::once_flag upper_flag;
+        LevelSchedule lower;
+        LevelSchedule upper;
+    };
+
     void _transform_basic_to_csr(const std::vector<std::vector<double>>& input_matrix);
     std::vector<std::vector<double>> _transform_csr_to_basic() const;
 
+    static size_t _count_nonzeros(const double* row, size_t size);
+
+    const LevelSchedule& _get_level_schedule(bool lower) const;
+    void _build_level_schedule(bool lower, LevelSchedule& schedule) const;
+    std::vector<double> _solve_triangular(const std::vector<double>& rhs, bool lower, bool unit_diagonal) const;
+
     static double _determinant_recursive(const std::vector<std::vector<double>>& matrix);
 
     std::vector<double> _values;
@@ -40,4 +74,6 @@ private:
 
     uint16_t _count_rows;
     uint16_t _count_cols;
+
+    std::shared_ptr<LevelCache> _levels = std::make_shared<LevelCache>();
 };
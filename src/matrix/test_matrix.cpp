@@ -1,6 +1,9 @@
 #include "test_matrix.h"
 #include "matrix.h"
 
+#include <algorithm>
+#include <thread>
+
 // Тест для конструктора и преобразования в CSR
 void test_constructor_and_csr() {
     const std::vector<std::vector<double>> input_matrix = {
@@ -158,4 +161,201 @@ void test_csr_to_basic() {
             CU_ASSERT_DOUBLE_EQUAL(basic_matrix[i][j], input_matrix[i][j], 1e-9);
         }
     }
+}
+
+// Тест записи матрицы в непрерывный буфер с шагом строки
+void test_csr_to_dense_buffer() {
+    const std::vector<std::vector<double>> input_matrix = {
+        {5, 0, 0},
+        {0, 8, 0},
+        {3, 0, 6}
+    };
+    const Matrix matrix(input_matrix);
+
+    constexpr size_t leading_dim = 4;
+    std::vector<double> buffer(leading_dim * input_matrix.size(), -1.0);
+    matrix.get_matrix(buffer.data(), leading_dim);
+
+    for (size_t i = 0; i < input_matrix.size(); i++) {
+        for (size_t j = 0; j < input_matrix[0].size(); j++) {
+            CU_ASSERT_DOUBLE_EQUAL(buffer[i * leading_dim + j], input_matrix[i][j], 1e-9);
+        }
+        CU_ASSERT_DOUBLE_EQUAL(buffer[i * leading_dim + 3], -1.0, 1e-9);
+    }
+}
+
+// Тест преобразования в CSR на матрице с сотнями строк разной заполненности (включая пустые строки),
+// достаточно большой, чтобы заполнение шло в нескольких потоках
+void test_constructor_and_csr_large() {
+    constexpr size_t rows = 600;
+    constexpr size_t cols = 70;
+    std::vector input_matrix(rows, std::vector(cols, 0.0));
+    for (size_t i = 0; i < rows; i++) {
+        if (i % 7 == 0) continue;
+        for (size_t j = 0; j < cols; j++) {
+            if ((i * 31 + j * 17) % (i % 11 + 2) == 0) {
+                input_matrix[i][j] = static_cast<double>(i * 100 + j + 1);
+            }
+        }
+    }
+    const Matrix matrix(input_matrix);
+
+    std::vector<double> expected_values;
+    std::vector<uint16_t> expected_column_idx;
+    std::vector<uint16_t> expected_row_ptr = {0};
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            if (input_matrix[i][j] != 0) {
+                expected_values.push_back(input_matrix[i][j]);
+                expected_column_idx.push_back(j);
+            }
+        }
+        expected_row_ptr.push_back(expected_values.size());
+    }
+
+    const std::vector<double> values = matrix.get_values();
+    const std::vector<uint16_t> column_idx = matrix.get_column_idx();
+    const std::vector<uint16_t> row_ptr = matrix.get_row_ptr();
+    CU_ASSERT_TRUE(row_ptr == expected_row_ptr);
+    CU_ASSERT_TRUE(column_idx == expected_column_idx);
+    CU_ASSERT_TRUE(values == expected_values);
+}
+
+// Тест матрицы, у которой ненулевых элементов больше, чем помещается в индексы CSR
+void test_constructor_too_many_nonzeros() {
+    constexpr size_t n = 300;
+    const std::vector input_matrix(n, std::vector(n, 1.0));
+    const Matrix matrix(input_matrix);
+
+    CU_ASSERT_TRUE(n * n > Matrix::MAX_NONZEROS);
+    CU_ASSERT_TRUE(matrix.get_values().empty());
+    CU_ASSERT_TRUE(matrix.get_column_idx().empty());
+    const std::vector<uint16_t> row_ptr = matrix.get_row_ptr();
+    CU_ASSERT_EQUAL(row_ptr.size(), n + 1);
+    CU_ASSERT_TRUE(std::all_of(row_ptr.begin(), row_ptr.end(), [](const uint16_t offset) { return offset == 0; }));
+}
+
+// Тест прямой подстановки (два разных вектора правой части на одном разбиении)
+void test_solve_lower_triangular() {
+    const std::vector<std::vector<double>> input_matrix = {
+        {2, 0, 0, 0},
+        {0, 4, 0, 0},
+        {1, 0, 1, 0},
+        {0, 2, 3, 5}
+    };
+    const Matrix matrix(input_matrix);
+
+    const std::vector<double> first = matrix.solve_lower_triangular({2, 8, 4, 26});
+    const std::vector<double> expected_first = {1, 2, 3, 2.6};
+    CU_ASSERT_EQUAL(first.size(), expected_first.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        CU_ASSERT_DOUBLE_EQUAL(first[i], expected_first[i], 1e-9);
+    }
+
+    const std::vector<double> second = matrix.solve_lower_triangular({4, 4, 2, 4});
+    const std::vector<double> expected_second = {2, 1, 0, 0.4};
+    CU_ASSERT_EQUAL(second.size(), expected_second.size());
+    for (size_t i = 0; i < second.size(); i++) {
+        CU_ASSERT_DOUBLE_EQUAL(second[i], expected_second[i], 1e-9);
+    }
+
+    const std::vector<double> unit = matrix.solve_lower_triangular({1, 1, 1, 1}, true);
+    const std::vector<double> expected_unit = {1, 1, 0, -1};
+    for (size_t i = 0; i < unit.size(); i++) {
+        CU_ASSERT_DOUBLE_EQUAL(unit[i], expected_unit[i], 1e-9);
+    }
+}
+
+// Тест обратной подстановки
+void test_solve_upper_triangular() {
+    const std::vector<std::vector<double>> input_matrix = {
+        {2, 1, 0},
+        {0, 3, 1},
+        {0, 0, 4}
+    };
+    const Matrix matrix(input_matrix);
+
+    const std::vector<double> solution = matrix.solve_upper_triangular({4, 11, 8});
+    const std::vector<double> expected = {0.5, 3, 2};
+    CU_ASSERT_EQUAL(solution.size(), expected.size());
+    for (size_t i = 0; i < solution.size(); i++) {
+        CU_ASSERT_DOUBLE_EQUAL(solution[i], expected[i], 1e-9);
+    }
+
+    const Matrix singular(std::vector<std::vector<double>>{{1, 1}, {0, 0}});
+    CU_ASSERT_TRUE(singular.solve_upper_triangular({1, 1}).empty());
+}
+
+// Тест одновременной подстановки из нескольких потоков с одной матрицей (общий кэш разбиения)
+void test_solve_triangular_concurrent() {
+    constexpr size_t n = 200;
+    constexpr size_t count_threads = 4;
+    std::vector input_matrix(n, std::vector(n, 0.0));
+    for (size_t i = 0; i < n; i++) {
+        input_matrix[i][i] = 2;
+        if (i > 0) {
+            input_matrix[i][i - 1] = 1;
+        }
+    }
+    const Matrix matrix(input_matrix);
+
+    // Решение x[i] = t + 1 для потока t: rhs[0] = 2 * (t + 1), rhs[i] = 3 * (t + 1)
+    std::vector<std::vector<double>> solutions(count_threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < count_threads; t++) {
+        threads.emplace_back([&matrix, &solutions, t] {
+            std::vector rhs(n, 3.0 * (t + 1));
+            rhs[0] = 2.0 * (t + 1);
+            solutions[t] = matrix.solve_lower_triangular(rhs);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < count_threads; t++) {
+        CU_ASSERT_EQUAL(solutions[t].size(), n);
+        for (size_t i = 0; i < solutions[t].size(); i++) {
+            CU_ASSERT_DOUBLE_EQUAL(solutions[t][i], static_cast<double>(t + 1), 1e-9);
+        }
+    }
+}
+
+// Тест подстановки с широкими уровнями (по 1000 строк), которые делятся между потоками
+void test_solve_triangular_wide_levels() {
+    constexpr size_t n = 3000;
+    constexpr size_t stride = 1000;
+    std::vector input_matrix(n, std::vector(n, 0.0));
+    std::vector<double> rhs(n);
+    for (size_t i = 0; i < n; i++) {
+        input_matrix[i][i] = 2;
+        if (i >= stride) {
+            input_matrix[i][i - stride] = 1;
+            input_matrix[i - stride][i] = -1;
+        }
+    }
+    const Matrix matrix(input_matrix);
+
+    // Решение x[i] = i % 7 + 1
+    std::vector<double> expected(n);
+    for (size_t i = 0; i < n; i++) {
+        expected[i] = static_cast<double>(i % 7 + 1);
+    }
+    for (size_t i = 0; i < n; i++) {
+        rhs[i] = 2 * expected[i] + (i >= stride ? expected[i - stride] : 0.0);
+    }
+    const std::vector<double> lower = matrix.solve_lower_triangular(rhs);
+    CU_ASSERT_EQUAL(lower.size(), n);
+    for (size_t i = 0; i < lower.size(); i++) {
+        CU_ASSERT_DOUBLE_EQUAL(lower[i], expected[i], 1e-9);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        rhs[i] = 2 * expected[i] - (i + stride < n ? expected[i + stride] : 0.0);
+    }
+    const std::vector<double> upper = matrix.solve_upper_triangular(rhs);
+    CU_ASSERT_EQUAL(upper.size(), n);
+    for (size_t i = 0; i < upper.size(); i++) {
+        CU_ASSERT_DOUBLE_EQUAL(upper[i], expected[i], 1e-9);
+    }
 }
\ No newline at end of file
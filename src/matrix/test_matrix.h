@@ -10,4 +10,11 @@ void test_get_determinant();
 void test_scalar_multiplication();
 void test_matrix_multiplication();
 void test_matrix_addition();
-void test_csr_to_basic();
\ No newline at end of file
+void test_csr_to_basic();
+void test_csr_to_dense_buffer();
+void test_constructor_and_csr_large();
+void test_constructor_too_many_nonzeros();
+void test_solve_lower_triangular();
+void test_solve_upper_triangular();
+void test_solve_triangular_concurrent();
+void test_solve_triangular_wide_levels();
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Признак того, что текущий поток уже выполняет часть параллельной работы
+ * (рабочий поток parallel_for или пула задач). Вложенные parallel_for в таком потоке
+ * выполняются последовательно, чтобы число потоков не перемножалось.
+ */
+inline thread_local bool is_parallel_worker = false;
+
+/**
+ * @brief Выполняет body(i) для всех i из [begin, end), разбивая диапазон на непрерывные блоки по потокам.
+ * @param begin Начало диапазона.
+ * @param end Конец диапазона (не включается).
+ * @param body Функция, вызываемая для каждого индекса. Должна быть безопасной для параллельного вызова.
+ * @param grain Минимальное количество индексов на один поток. Короткие диапазоны (и вызовы из рабочих потоков)
+ *              выполняются в текущем потоке.
+ */
+template<typename Function>
+void parallel_for(const size_t begin, const size_t end, Function&& body, const size_t grain = 64) {
+    if (begin >= end) return;
+    const size_t count = end - begin;
+    const size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t count_threads = std::min(hardware, (count + grain - 1) / std::max<size_t>(1, grain));
+    if (count_threads <= 1 || is_parallel_worker) {
+        for (size_t i = begin; i < end; i++) {
+            body(i);
+        }
+        return;
+    }
+    const size_t chunk = (count + count_threads - 1) / count_threads;
+    std::vector<std::thread> workers;
+    workers.reserve(count_threads - 1);
+    for (size_t t = 1; t < count_threads; t++) {
+        const size_t chunk_begin = begin + t * chunk;
+        const size_t chunk_end = std::min(end, chunk_begin + chunk);
+        if (chunk_begin >= chunk_end) break;
+        workers.emplace_back([&body, chunk_begin, chunk_end] {
+            is_parallel_worker = true;
+            for (size_t i = chunk_begin; i < chunk_end; i++) {
+                body(i);
+            }
+        });
+    }
+    const size_t first_end = std::min(end, begin + chunk);
+    is_parallel_worker = true;
+    for (size_t i = begin; i < first_end; i++) {
+        body(i);
+    }
+    is_parallel_worker = false;
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Барьер для фиксированного числа потоков с ожиданием через std::this_thread::yield.
+ *
+ * Рассчитан на короткие фазы (уровни треугольной подстановки), где засыпание на условной переменной
+ * стоило бы дороже самой фазы. Записи, сделанные до барьера, видны всем потокам после него.
+ */
+class SpinBarrier {
+public:
+    explicit SpinBarrier(const size_t count_threads) : _count_threads(count_threads) {}
+
+    void arrive_and_wait() {
+        const size_t generation = _generation.load(std::memory_order_acquire);
+        if (_waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == _count_threads) {
+            _waiting.store(0, std::memory_order_relaxed);
+            _generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        while (_generation.load(std::memory_order_acquire) == generation) {
+            std::this_thread::yield();
+        }
+    }
+private:
+    const size_t _count_threads;
+    std::atomic<size_t> _waiting = 0;
+    std::atomic<size_t> _generation = 0;
+};
+
+/**
+ * @brief Выполняет body(i) по уровням: уровни идут строго по очереди, индексы внутри уровня — параллельно.
+ * @param level_ptr Границы уровней: уровень l содержит индексы [level_ptr[l], level_ptr[l + 1]).
+ * @param body Функция, вызываемая для каждого индекса.
+ * @param grain Минимальное количество индексов на поток; более узкие уровни выполняет один поток.
+ *
+ * @details
+ * Потоки создаются один раз на весь вызов и разделяются барьером между уровнями, поэтому стоимость
+ * запуска потоков не умножается на количество уровней. Если ни один уровень не шире `grain`,
+ * всё выполняется в текущем потоке без барьеров.
+ */
+template<typename Index, typename Function>
+void parallel_for_levels(const std::vector<Index>& level_ptr, Function&& body, const size_t grain = 256) {
+    if (level_ptr.size() < 2) return;
+    size_t max_width = 0;
+    for (size_t l = 0; l + 1 < level_ptr.size(); l++) {
+        max_width = std::max<size_t>(max_width, level_ptr[l + 1] - level_ptr[l]);
+    }
+    const size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t count_threads = std::min(hardware, max_width / std::max<size_t>(1, grain));
+    if (count_threads <= 1 || is_parallel_worker) {
+        for (size_t i = level_ptr.front(); i < level_ptr.back(); i++) {
+            body(i);
+        }
+        return;
+    }
+
+    SpinBarrier barrier(count_threads);
+    const auto run = [&](const size_t t) {
+        is_parallel_worker = true;
+        for (size_t l = 0; l + 1 < level_ptr.size(); l++) {
+            const size_t begin = level_ptr[l];
+            const size_t end = level_ptr[l + 1];
+            if (end - begin < 2 * grain) {
+                if (t == 0) {
+                    for (size_t i = begin; i < end; i++) {
+                        body(i);
+                    }
+                }
+            } else {
+                const size_t chunk = (end - begin + count_threads - 1) / count_threads;
+                const size_t chunk_end = std::min(end, begin + (t + 1) * chunk);
+                for (size_t i = begin + t * chunk; i < chunk_end; i++) {
+                    body(i);
+                }
+            }
+            barrier.arrive_and_wait();
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(count_threads - 1);
+    for (size_t t = 1; t < count_threads; t++) {
+        workers.emplace_back(run, t);
+    }
+    run(0);
+    is_parallel_worker = false;
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}